@@ -8,7 +8,10 @@
 // ============================================
 // TIMING CONFIGURATION
 // ============================================
-#define SMS_CHECK_INTERVAL 10000      // Check for new SMS every 10 seconds
+#define SMS_CHECK_INTERVAL 60000      // Safety-net SIM scan; new SMS normally arrive via +CMTI / RING
+#define SMS_RETRY_INTERVAL 10000      // Rescan after a failed send (the SMS is still on the SIM)
+#define SMS_SEND_ATTEMPTS 3           // POSTs of a SIM message, SMS_RETRY_INTERVAL × attempt apart, before
+                                      // it goes back to the SIM so the messages behind it move on
 #define NETWORK_CHECK_INTERVAL 60000  // Check WiFi status every 60 seconds
 #define HTTP_TIMEOUT 30000            // HTTP request timeout (30 seconds)
 #define WIFI_CONNECT_TIMEOUT 15000    // WiFi connection timeout (15 seconds)
@@ -33,5 +36,83 @@
 // SMS CONFIGURATION
 // ============================================
 #define SMS_DELETE_AFTER_SEND 1       // Delete SMS from SIM after successful send to server
+#define SMS_DIRECT_DELIVERY 0         // 1 = SMS arrive inline (+CMT) and are acknowledged with AT+CNMA
+                                      //     once written to storage (AT+CMGW)
+#define SMS_STORAGE_PREFERRED "MT"    // AT+CPMS storage: "MT" = modem (ME) + SIM (SM) combined
+#define SMS_STORAGE_FALLBACK "SM"     // Used if the modem rejects the preferred storage
+#define SMS_STORAGE_DRAIN_FREE 5      // Drain mode at or below this many free slots
+
+// Inbox paging: pages are read back to back while SMS remain on the SIM,
+// held back only while the uplink queue is at its high-water mark
+#define SMS_INBOX_PAGE_SIZE 10        // SMS decoded per AT+CMGL
+#define SMS_OUTBOX_CAPACITY 16        // Decoded messages waiting for the server
+#define SMS_OUTBOX_HIGH_WATER 8       // Stop paging the SIM at this bulk queue depth
+
+// Priority lane: one-time codes and chosen senders overtake the bulk backlog
+#define SMS_PRIORITY_ENABLED 1
+#define SMS_PRIORITY_SENDERS ""       // Comma-separated sender IDs or numbers, e.g. "MyBank,PayPal,900"
+#define SMS_PRIORITY_SHORT_CODES 0    // 1 = every short-code sender is priority
+#define SMS_PRIORITY_OTP 1            // Detect one-time codes (keyword + standalone digit run)
+#define SMS_OTP_MIN_DIGITS 4
+#define SMS_OTP_MAX_DIGITS 8
+#define SMS_OUTBOX_PRIORITY_RESERVE 4 // Outbox entries only the priority lane may take
+
+// Multi-part reassembly pool (preallocated once, no per-part heap allocation)
+#define SMS_CONCAT_SLOTS 4            // Multi-part messages reassembled in parallel
+#ifdef BOARD_HAS_PSRAM
+  #define SMS_CONCAT_MAX_PARTS 255    // Full protocol range, part text lives in PSRAM (~117 KB/slot)
+#else
+  #define SMS_CONCAT_MAX_PARTS 16     // Internal RAM only (~7 KB/slot)
+#endif
+
+// How long to wait for missing parts, per sender class (ms)
+#define SMS_CONCAT_TIMEOUT_PHONE 300000       // Person-to-person: parts may take different routes
+#define SMS_CONCAT_TIMEOUT_SHORT_CODE 120000  // Service numbers send all parts in one burst
+#define SMS_CONCAT_TIMEOUT_ALPHANUMERIC 120000
+
+// What happens to a multi-part message whose parts don't all arrive in time
+#define SMS_CONCAT_POLICY_DROP 0      // Discard the received parts
+#define SMS_CONCAT_POLICY_FORWARD 1   // Send what arrived, with gap markers and missing-part metadata
+#define SMS_CONCAT_TIMEOUT_POLICY SMS_CONCAT_POLICY_FORWARD
+#define SMS_CONCAT_GAP_MARKER "[...]"           // Stands in for each missing part's text
+#define SMS_CONCAT_RETRY_INTERVAL 10000         // Retry a partial the server didn't accept (ms)
+#define SMS_CONCAT_LATE_WINDOW 3600000          // Late parts within 1 hour are sent as amendments
+#define SMS_CONCAT_FLUSHED_KEYS 8               // Timed-out messages remembered for amendments and redeliveries
+
+// Multi-part journal: buffered parts are logged to LittleFS before their SIM delete
+#define SMS_JOURNAL_ENABLED 1
+#define SMS_JOURNAL_PATH "/sms_journal.log"
+#define SMS_JOURNAL_REWRITE_PATH "/sms_journal.tmp"
+#define SMS_JOURNAL_BATCH_BYTES 4096          // Records written per flush (one fsync)
+#define SMS_JOURNAL_COMPACT_BYTES 65536       // Rewrite the log with only live parts above this size
+
+// Duplicate detection: fingerprints of consumed SMS, persisted in NVS
+#define SMS_DEDUP_ENABLED 1
+#define SMS_DEDUP_CAPACITY 256                // Fingerprints remembered (power of two, 8 bytes each)
+
+// ============================================
+// PIPELINE TASKS
+// ============================================
+// Modem (AT/UART) → decode (PDU, reassembly, journal) → uplink (HTTPS)
+// Core 0 runs the WiFi/TLS stack, core 1 the Arduino loop and modem UART
+#define MODEM_TASK_CORE 1
+#define MODEM_TASK_PRIORITY 3         // Highest: keeps the UART and +CNMA deadlines
+#define MODEM_TASK_STACK 8192
+#define DECODE_TASK_CORE 1
+#define DECODE_TASK_PRIORITY 2
+#define DECODE_TASK_STACK 8192
+#define UPLINK_TASK_CORE 0
+#define UPLINK_TASK_PRIORITY 2
+#define UPLINK_TASK_STACK 12288       // TLS handshake
+// Longest wait to store a +CMT message before answering RP-ERROR (ms);
+// the RP-ACK must reach the network inside its TR2M timer (12-20 s)
+#define SMS_DIRECT_ACK_TIMEOUT 5000
+
+// Tasks block on events (UART, RING, WiFi, queues, deadlines) instead of
+// polling, so the chip can light-sleep while all of them wait. Needs
+// CONFIG_PM_ENABLE in the ESP-IDF sdkconfig; off with SMS_DIRECT_DELIVERY
+#define POWER_LIGHT_SLEEP 1
+#define POWER_CPU_MAX_MHZ 240
+#define POWER_CPU_MIN_MHZ 80          // APB clock floor for the modem UART
 
 #endif // CONFIG_H
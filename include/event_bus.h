@@ -0,0 +1,48 @@
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+
+// Wake-up sources, one bit each (an event group holds 24)
+namespace EventBit {
+    constexpr EventBits_t MODEM_UART = 1 << 0;     // Bytes from the modem outside an AT command
+    constexpr EventBits_t MODEM_RING = 1 << 1;     // RING pin pulse
+    constexpr EventBits_t SLOT_DONE = 1 << 2;      // Outcome posted for the modem task
+    constexpr EventBits_t PIPELINE_FREE = 1 << 3;  // Decode or uplink took an item: room to page
+    constexpr EventBits_t RAW_READY = 1 << 4;      // PDU queued for the decode task
+    constexpr EventBits_t RESULT_READY = 1 << 5;   // Uplink handed an entry back
+    constexpr EventBits_t WIFI_UP = 1 << 6;        // Level: set while WiFi has an IP
+    constexpr EventBits_t WIFI_LOST = 1 << 7;      // WiFi dropped
+    constexpr EventBits_t UPLINK_READY = 1 << 8;   // Entry queued on either uplink lane
+}
+
+// One FreeRTOS event group shared by the pipeline tasks
+// Each task blocks on its own bits, with a timeout no longer than its next
+// deadline, instead of polling. A bit set while its task is busy stays set,
+// so the next wait returns at once and no wake-up is lost.
+class EventBus {
+public:
+    static bool init();
+
+    static void signal(EventBits_t bits);
+    static void IRAM_ATTR signalFromIsr(EventBits_t bits);
+    static void clear(EventBits_t bits);
+    static bool isSet(EventBits_t bits);
+
+    // Block until any of the bits is set (those bits are cleared) or timeout
+    // Returns the bits that woke the task, 0 on timeout
+    static EventBits_t wait(EventBits_t bits, TickType_t timeout);
+
+    // Block until a level bit (WIFI_UP) is set, leaving it set
+    static bool waitLevel(EventBits_t bit, TickType_t timeout);
+
+    // Ticks from now until a millis() deadline (0 once it has passed)
+    static TickType_t ticksUntil(unsigned long deadline);
+
+private:
+    static EventGroupHandle_t group;
+};
+
+#endif // EVENT_BUS_H
@@ -16,9 +16,15 @@ public:
     // Send SMS to server
     bool sendSmsToServer(const SmsMessage& sms);
 
-    // Get last HTTP status code
+    // Get last HTTP status code (0 = no response)
     int getLastStatusCode() const { return lastStatusCode; }
 
+    // The server rejected the message itself (4xx other than timeout or rate
+    // limit): sending it again unchanged won't help
+    bool isPermanentFailure() const {
+        return lastStatusCode >= 400 && lastStatusCode < 500 && lastStatusCode != 408 && lastStatusCode != 429;
+    }
+
     // Get last error message
     String getLastError() const { return lastError; }
 
@@ -0,0 +1,61 @@
+#ifndef DUPLICATE_FILTER_H
+#define DUPLICATE_FILTER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "sms_types.h"
+
+// Fingerprint table sizing
+namespace DedupConst {
+    constexpr int TABLE_SIZE = SMS_DEDUP_CAPACITY * 2;  // Open-addressing index, load ≤ 0.5
+    constexpr uint16_t EMPTY = 0xFFFF;
+
+    // FNV-1a (64-bit)
+    constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+}
+
+static_assert((SMS_DEDUP_CAPACITY & (SMS_DEDUP_CAPACITY - 1)) == 0, "SMS_DEDUP_CAPACITY must be a power of two");
+
+// Remembers fingerprints of SMS parts already consumed (delivered or journaled)
+// so network re-deliveries and re-reads of the same SIM index are dropped.
+// The last SMS_DEDUP_CAPACITY fingerprints are kept in a ring (oldest evicted
+// first) with a linear-probing index for O(1) lookup. The ring is persisted
+// to NVS by commit(); the index is rebuilt from it on init().
+class DuplicateFilter {
+public:
+    DuplicateFilter();
+
+    // Load the ring from NVS
+    bool init();
+
+    // 64-bit fingerprint over sender, SCTS timestamp, reference/part and text
+    static uint64_t fingerprint(const SmsMessage& sms);
+
+    bool contains(uint64_t fp) const { return find(fp) >= 0; }
+
+    // Remember a consumed fingerprint (evicts the oldest when full)
+    void insert(uint64_t fp);
+
+    // Persist the ring if it changed (one NVS write per call)
+    bool commit();
+
+    uint32_t getDuplicateCount() const { return duplicateCount; }
+    void countDuplicate() { duplicateCount++; }
+
+private:
+    uint64_t ring[SMS_DEDUP_CAPACITY];      // Fingerprints in insertion order
+    uint16_t index[DedupConst::TABLE_SIZE]; // Ring positions, probed by fingerprint
+    uint16_t head;                          // Next ring position to write
+    uint16_t count;
+    bool dirty;
+    uint32_t duplicateCount;
+
+    int find(uint64_t fp) const;
+    void indexInsert(uint16_t ringPos);
+    void indexRemove(uint64_t fp);
+    static int homeBucket(uint64_t fp) { return (int)(fp >> 32) & (DedupConst::TABLE_SIZE - 1); }
+    static uint64_t mix(uint64_t hash, const uint8_t* data, size_t length);
+};
+
+#endif // DUPLICATE_FILTER_H
@@ -0,0 +1,51 @@
+#ifndef GSM7_TABLES_H
+#define GSM7_TABLES_H
+
+#include <Arduino.h>
+
+// One GSM 7-bit code → its UTF-8 bytes, precomputed
+// - len: UTF-8 byte count (0 = no character at this code)
+// - bytes: UTF-8 sequence, NUL padded
+struct Gsm7Utf8 {
+    uint8_t len;
+    char bytes[4];
+};
+
+// National language identifiers (3GPP TS 23.038, 6.2.1.2.4)
+namespace Gsm7Language {
+    constexpr uint8_t DEFAULT = 0;
+    constexpr uint8_t TURKISH = 1;
+    constexpr uint8_t SPANISH = 2;     // Single shift only
+    constexpr uint8_t PORTUGUESE = 3;
+    constexpr uint8_t BENGALI = 4;
+    constexpr uint8_t GUJARATI = 5;
+    constexpr uint8_t HINDI = 6;
+    constexpr uint8_t KANNADA = 7;
+    constexpr uint8_t MALAYALAM = 8;
+    constexpr uint8_t ORIYA = 9;
+    constexpr uint8_t PUNJABI = 10;
+    constexpr uint8_t TAMIL = 11;
+    constexpr uint8_t TELUGU = 12;
+    constexpr uint8_t URDU = 13;
+}
+
+// Shift tables selected by the UDH (IEI 0x25 locking, IEI 0x24 single)
+struct Gsm7Shift {
+    uint8_t locking;  // Replaces the default alphabet
+    uint8_t single;   // Replaces the extension table reached via ESC
+
+    Gsm7Shift() : locking(Gsm7Language::DEFAULT), single(Gsm7Language::DEFAULT) {}
+};
+
+// 3GPP TS 23.038 alphabet tables, direct-indexed by septet value
+namespace Gsm7Tables {
+    extern const Gsm7Utf8 BASIC[128];     // Default alphabet (ESC has len 0)
+    extern const Gsm7Utf8 EXTENDED[128];  // Default extension table, reached via ESC
+
+    // Tables for a national language
+    // Languages without a table of that kind fall back to the default one
+    const Gsm7Utf8* lockingShift(uint8_t language);
+    const Gsm7Utf8* singleShift(uint8_t language);
+}
+
+#endif // GSM7_TABLES_H
@@ -0,0 +1,30 @@
+#ifndef HEX_DECODER_H
+#define HEX_DECODER_H
+
+#include <Arduino.h>
+
+// Hex decoding constants
+namespace HexConst {
+    constexpr uint8_t INVALID_FLAG = 0xF0;  // Any of these bits set = invalid nibble
+}
+
+// Table-driven hex → binary conversion
+// Accepts upper and lower case digits
+class HexDecoder {
+public:
+    // Decode hex character pairs into bytes
+    // - hex/len: input characters (len must be even)
+    // - out/outCap: destination buffer
+    // - badPos: optional, receives offset of the first offending character
+    // Returns number of bytes written, or -1 on invalid input or overflow
+    static int decode(const char* hex, size_t len, uint8_t* out, size_t outCap, int* badPos = nullptr);
+
+    // Single character → nibble value (INVALID_FLAG bits set if not hex)
+    static uint8_t nibble(char c) { return NIBBLE[(uint8_t)c]; }
+
+private:
+    // ASCII → nibble lookup table
+    static const uint8_t NIBBLE[256];
+};
+
+#endif // HEX_DECODER_H
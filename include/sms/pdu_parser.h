@@ -3,15 +3,23 @@
 
 #include <Arduino.h>
 #include "sms_types.h"
+#include "gsm7_tables.h"
 
 // PDU constants
 namespace PduConst {
+    // Size limits (3GPP TS 23.040)
+    constexpr int MAX_PDU_OCTETS = 176;          // SMSC (12) + SMS-DELIVER TPDU (164)
+    constexpr int MAX_UD_OCTETS = 140;           // User Data field
+    constexpr int MAX_UD_SEPTETS = 160;          // User Data field, GSM 7-bit
+
     // PDU Type flags
     constexpr uint8_t UDHI_FLAG = 0x40;  // Bit 6: User Data Header Indicator
 
     // Type of Address
     constexpr uint8_t TOA_TYPE_MASK = 0x70;      // Bits 6-4: address type
     constexpr uint8_t TOA_ALPHANUMERIC = 0x50;   // 101 = alphanumeric sender
+    constexpr int SHORT_CODE_MAX_DIGITS = 6;     // Numeric senders up to this length are short codes
+    constexpr int MAX_ADDRESS_DIGITS = 20;       // TP-OA: 10 octets of semi-octets
 
     // Data Coding Scheme (DCS)
     constexpr uint8_t DCS_ENCODING_MASK = 0x0C;  // Bits 3-2: encoding type
@@ -22,37 +30,64 @@ namespace PduConst {
     // User Data Header IEI (Information Element Identifier)
     constexpr uint8_t IEI_CONCAT_8BIT = 0x00;    // Concatenated SMS (8-bit reference)
     constexpr uint8_t IEI_CONCAT_16BIT = 0x08;   // Concatenated SMS (16-bit reference)
+    constexpr uint8_t IEI_SINGLE_SHIFT = 0x24;   // National language single shift
+    constexpr uint8_t IEI_LOCKING_SHIFT = 0x25;  // National language locking shift
 
     // Bit masks
     constexpr uint8_t NIBBLE_LOW = 0x0F;         // Lower 4 bits
     constexpr uint8_t NIBBLE_HIGH = 0xF0;        // Upper 4 bits
+    constexpr uint8_t TZ_SIGN = 0x08;            // Timezone sign bit (in low nibble)
 }
 
+// Scratch memory for one parse, owned by the caller
+// Keep one per task so parses on both cores never share state
+struct PduScratch {
+    uint8_t pdu[PduConst::MAX_PDU_OCTETS];  // Binary PDU decoded from hex
+};
+
+// One PDU framed from the modem UART, not decoded yet
+// Plain data, so it can be copied through a FreeRTOS queue
+struct SmsRawPdu {
+    int16_t index;                           // Storage index (SMS_INDEX_DIRECT for +CMT)
+    uint8_t length;                          // Octets in pdu (0 = malformed)
+    uint32_t readAt;                         // millis() when framed (uplink latency)
+    uint8_t pdu[PduConst::MAX_PDU_OCTETS];
+};
+
 // Low-level PDU parsing
 // Converts raw PDU hex string → SmsMessage structure
+// Holds no static state: all scratch memory comes from PduScratch
 class PduParser {
 public:
-    // Parse PDU hex string into SmsMessage
+    // Parse PDU hex characters into SmsMessage
+    // - hex: view into the modem response (not NUL-terminated, not copied)
+    // - len: number of hex characters
+    // - scratch: working memory for this parse
     // Returns true on success, false on parse error
+    static bool parse(const char* hex, size_t len, SmsMessage& out, PduScratch& scratch);
+
+    // Convenience overloads using scratch on the caller's stack
+    static bool parse(const char* hex, size_t len, SmsMessage& out);
     static bool parse(const String& pduHex, SmsMessage& out);
 
-private:
-    // Helper: hex char pair → byte
-    static uint8_t hexToByte(char high, char low);
+    // Parse already-decoded PDU octets
+    static bool parseBytes(const uint8_t* pdu, int len, SmsMessage& out);
 
+private:
     // Decode sender address (phone number or alphanumeric)
-    static String decodeSender(const String& pdu, int& pos, int senderLen, uint8_t typeOfAddr);
-    static String decodePhoneNumber(const String& pdu, int& pos, int digitCount);
-    static String decodeAlphanumeric(const String& pdu, int& pos, int senderLen);
+    static String decodeSender(const uint8_t* pdu, int& pos, int senderLen, uint8_t typeOfAddr);
+    static String decodePhoneNumber(const uint8_t* pdu, int& pos, int digitCount);
+    static String decodeAlphanumeric(const uint8_t* pdu, int& pos, int senderLen);
 
     // Decode timestamp (7 octets, semi-octet format)
-    static String decodeTimestamp(const String& pdu, int& pos);
+    static String decodeTimestamp(const uint8_t* pdu, int& pos);
 
-    // Parse UDH (User Data Header) for multi-part SMS
-    static bool parseUdh(const uint8_t* data, int udhLen, SmsPartInfo& partInfo);
+    // Parse UDH (User Data Header): multi-part info and national language shifts
+    static bool parseUdh(const uint8_t* data, int udhLen, SmsPartInfo& partInfo, Gsm7Shift& shift);
 
     // Decode user data (text) based on DCS encoding
-    static String decodeUserData(const String& pdu, int& pos, uint8_t dcs, int udl,
+    // - ud/udBytes: User Data field as received (after UDL octet)
+    static String decodeUserData(const uint8_t* ud, int udBytes, uint8_t dcs, int udl,
                                   bool hasUdh, SmsPartInfo& partInfo);
 };
 
@@ -0,0 +1,57 @@
+#ifndef PDU_STREAM_PARSER_H
+#define PDU_STREAM_PARSER_H
+
+#include <Arduino.h>
+#include "sms_types.h"
+#include "pdu_parser.h"
+
+// Incremental PDU decoder fed one character at a time from the modem UART
+// Hex pairs are converted to octets as they arrive and the header fields are
+// tracked on the fly, so the expected PDU length is known before the line ends.
+// Peak memory is one binary PDU (176 bytes) instead of the whole AT response.
+class PduStreamParser {
+public:
+    enum class Result {
+        NEED_MORE,  // Keep feeding
+        COMPLETE,   // Line terminated, PDU complete: call finish()
+        ERROR       // Line terminated, PDU malformed or truncated
+    };
+
+    PduStreamParser();
+
+    // Prepare for a new PDU line
+    // - expectedTpduLen: <length> from the +CMGL/+CMT header (0 = unknown)
+    void reset(int expectedTpduLen = 0);
+
+    // Feed one character; CR or LF terminates the PDU line
+    // Leading CR/LF before the first hex digit are ignored
+    Result feed(char c);
+
+    // Decode the collected octets into SmsMessage (after COMPLETE)
+    bool finish(SmsMessage& out) const;
+
+    // Collected octets (valid after COMPLETE)
+    const uint8_t* data() const { return scratch.pdu; }
+    int length() const { return octetCount; }
+
+private:
+    // PDU fields, in wire order
+    enum class Field : uint8_t {
+        SMSC_LEN, SMSC, FIRST_OCTET, OA_LEN, OA_TOA, OA, PID, DCS, SCTS, UDL, UD, DONE, INVALID
+    };
+
+    PduScratch scratch;
+    int octetCount;
+    int smscOctets;       // Octets before the TPDU
+    int expectedTpduLen;
+    int remaining;        // Octets left in the current variable-length field
+    Field field;
+    uint8_t highNibble;
+    bool haveHigh;
+    uint8_t dcs;
+
+    // Advance the field state machine with one complete octet
+    void onOctet(uint8_t octet);
+};
+
+#endif // PDU_STREAM_PARSER_H
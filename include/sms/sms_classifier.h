@@ -0,0 +1,48 @@
+#ifndef SMS_CLASSIFIER_H
+#define SMS_CLASSIFIER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "sms_types.h"
+
+// OTP keywords are whole words, case-insensitive for ASCII and Cyrillic
+// (lowercase here); prefixes also match a longer word ("verif" → verify,
+// verification). A digit run right after a reference word is an order or
+// account number, and a 19xx/20xx run is taken as a year, not a code
+namespace OtpConst {
+    constexpr const char* KEYWORDS[] = {
+        "code", "otp", "passcode", "password", "pin", "token", "2fa", "код", "пароль"
+    };
+    constexpr const char* KEYWORD_PREFIXES[] = { "verif" };
+    constexpr const char* REFERENCE_WORDS[] = {
+        "order", "ref", "reference", "invoice", "ticket", "tracking", "account", "card", "заказ"
+    };
+}
+
+// Picks the uplink lane of a parsed message
+// PRIORITY when the sender is listed in SMS_PRIORITY_SENDERS, is a short code
+// (SMS_PRIORITY_SHORT_CODES) or the text looks like a one-time code: an OTP
+// keyword plus a standalone run of SMS_OTP_MIN_DIGITS..SMS_OTP_MAX_DIGITS
+// digits ("123456", "123-456", "123 456")
+// Stateless and allocation-free, so it runs on every decoded part
+class SmsClassifier {
+public:
+    static SmsLane classify(const SmsMessage& sms);
+
+    static bool isPrioritySender(const SmsMessage& sms);
+    static bool looksLikeOtp(const String& text);
+
+private:
+    static bool senderListed(const char* sender, const char* list);
+    static bool hasKeyword(const char* text);
+    static bool hasCode(const char* text);
+    static bool isYear(const char* run, int length);
+    static bool followsReferenceWord(const char* text, const char* run);
+
+    // Length of text matched by a lowercase word at p (0 = no match)
+    // Folds ASCII and Cyrillic А-Я/Ё, which keep their UTF-8 length
+    static size_t matchFolded(const char* p, const char* word);
+    static bool isWordChar(char c) { return isalnum((unsigned char)c) || (uint8_t)c >= 0x80; }
+};
+
+#endif // SMS_CLASSIFIER_H
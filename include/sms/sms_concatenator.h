@@ -2,41 +2,188 @@
 #define SMS_CONCATENATOR_H
 
 #include <Arduino.h>
-#include <map>
-#include <vector>
+#include "config.h"
 #include "sms_types.h"
+#include "text_decoder.h"
+#include "sms_journal.h"
 
-// High-level multi-part SMS handler
-// Buffers partial messages and concatenates when all parts arrive
+// Reassembly limits
+namespace ConcatConst {
+    // UTF-8 bytes one part can decode to: 153 septets × 3 bytes
+    // (UCS-2 parts are smaller: 67 units × 3 bytes)
+    constexpr int PART_TEXT_CAPACITY = 153 * Gsm7Const::MAX_UTF8_PER_SEPTET;
+    constexpr int MASK_WORDS = (SMS_CONCAT_MAX_PARTS + 31) / 32;
+    constexpr int SENDER_CAPACITY = 40;     // 11 alphanumeric chars × 3 bytes + NUL
+    constexpr int TIMESTAMP_CAPACITY = 32;  // "YYYY-MM-DD HH:MM:SS+HH:MM" + NUL
+    constexpr int ORPHAN_KEYS = 8;          // Journaled messages restore found no slot for
+
+    // FNV-1a (32-bit) for the reassembly key
+    constexpr uint32_t FNV_OFFSET = 2166136261UL;
+    constexpr uint32_t FNV_PRIME = 16777619UL;
+}
+
+// One multi-part message being reassembled
+// Keyed on (sender, reference, reference width, total parts); keyHash only
+// picks the home slot and short-circuits the full compare
+// Part text lives in the shared arena: SMS_CONCAT_MAX_PARTS × PART_TEXT_CAPACITY per slot
+struct SmsReassemblySlot {
+    bool inUse;
+    uint32_t keyHash;
+    uint16_t refNumber;
+    bool ref16Bit;
+    uint8_t totalParts;
+    uint8_t receivedCount;
+    SenderClass senderClass;
+    int lastIndex;                                   // SIM index of the latest part
+    uint32_t receivedMask[ConcatConst::MASK_WORDS];  // Bit (n-1) set = part n stored
+    uint16_t partLength[SMS_CONCAT_MAX_PARTS];
+    char* partText;                                  // Slot's region of the arena
+    char sender[ConcatConst::SENDER_CAPACITY];
+    char timestamp[ConcatConst::TIMESTAMP_CAPACITY];
+    unsigned long deadline;       // millis() at which missing parts are given up on
+
+    SmsReassemblySlot() : inUse(false), keyHash(0), refNumber(0), ref16Bit(false), totalParts(0), receivedCount(0),
+                          senderClass(SenderClass::PHONE), lastIndex(-1), receivedMask(), partLength(),
+                          partText(nullptr), deadline(0) {}
+};
 
-struct SmsPartBuffer {
-    String sender;
-    String timestamp;
-    std::vector<String> parts;  // Indexed by partNumber-1
+// Key of a message already delivered by the timeout path, so late parts
+// become amendments and redelivered ones are dropped
+struct SmsFlushedKey {
+    bool inUse;
+    uint32_t keyHash;
+    uint16_t refNumber;
+    bool ref16Bit;
     uint8_t totalParts;
-    unsigned long firstPartTime;  // millis() when first part arrived
+    uint32_t missingMask[ConcatConst::MASK_WORDS];  // Parts still expected as amendments
+    char sender[ConcatConst::SENDER_CAPACITY];
+    unsigned long flushedAt;  // millis() when the partial was delivered
 
-    SmsPartBuffer() : totalParts(0), firstPartTime(0) {}
+    SmsFlushedKey() : inUse(false), keyHash(0), refNumber(0), ref16Bit(false), totalParts(0),
+                      missingMask(), flushedAt(0) {}
 };
 
+// Key of a journaled message restore found no slot for (SMS_CONCAT_SLOTS
+// lowered): compaction carries its PART records over as they are
+struct SmsOrphanKey {
+    bool inUse;
+    uint32_t keyHash;
+    uint16_t refNumber;
+    bool ref16Bit;
+    uint8_t totalParts;
+    char sender[ConcatConst::SENDER_CAPACITY];
+
+    SmsOrphanKey() : inUse(false), keyHash(0), refNumber(0), ref16Bit(false), totalParts(0), sender() {}
+};
+
+// High-level multi-part SMS handler
+// Buffers partial messages and concatenates when all parts arrive
+// Fixed pool of SMS_CONCAT_SLOTS slots, allocated once in init()
 class SmsConcatenator {
 public:
     SmsConcatenator() = default;
 
+    // Allocate the part text arena (PSRAM when available)
+    // With a journal, buffered parts are logged to it and restored from it here
+    bool init(SmsJournal* journal = nullptr);
+
     // Add a SMS part and return concatenated message if complete
     // Returns nullptr if more parts are needed
     // For single-part SMS, returns immediately
+    // A late part of a message delivered as PARTIAL (or being sent as one,
+    // between nextExpired() and completeExpired()) returns as an AMENDMENT;
+    // a part it already carried returns nullptr and needs no journaling
+    // A completed message keeps its slot until markDelivered()
+    // With the pool full a new message is never made room for by dropping
+    // a buffered one: check hasRoomFor() first
     SmsMessage* addPart(const SmsMessage& sms);
 
-    // Clean up old partial messages (call periodically)
-    void cleanup();
+    // False if the part starts a new message and every slot is taken
+    // The caller should leave the part on the SIM (or RP-ERROR a +CMT) and
+    // call expediteOldest()
+    bool hasRoomFor(const SmsMessage& sms) const;
+
+    // Pull the earliest deadline forward to now, so nextExpired() resolves
+    // that message under the timeout policy and frees its slot
+    void expediteOldest();
+
+    // The server accepted a message returned by addPart(): free its parts
+    void markDelivered(const SmsMessage& sms);
+
+    // Write journaled parts to flash; call before deleting buffered parts from the SIM
+    // Returns false if any part since the last call may not be on flash
+    bool flushJournal();
+
+    // Resolve the earliest partial message whose deadline has passed
+    // FORWARD policy: returns it as a PARTIAL message; report the outcome with completeExpired()
+    // DROP policy: discards every expired message and returns nullptr
+    SmsMessage* nextExpired();
+
+    // Delivered: release the message from nextExpired() and remember its key
+    // for amendments and redelivered parts
+    // Not delivered: keep it and retry after SMS_CONCAT_RETRY_INTERVAL
+    void completeExpired(bool delivered);
+
+    // Earliest pending deadline; false when nothing is buffered
+    bool nextDeadline(unsigned long& deadline) const;
+
+    // Messages that shared a reference with one already buffered but had a
+    // different key: a reference-only key would have merged them
+    uint32_t getCollisionCount() const { return collisionCount; }
 
 private:
-    std::map<uint16_t, SmsPartBuffer> partBuffers;  // Key: refNumber
-    static const unsigned long PART_TIMEOUT = 300000; // 5 minutes
+    SmsReassemblySlot slots[SMS_CONCAT_SLOTS];
+    char* arena = nullptr;
+    SmsJournal* journal = nullptr;
+    bool journalOk = true;    // Every append since the last flushJournal() succeeded
+    SmsOrphanKey orphans[ConcatConst::ORPHAN_KEYS];
+    bool orphansUntracked = false;  // More orphaned messages than keys: don't compact
+    uint32_t collisionCount = 0;
+
+    // Min-heap of in-use slots ordered by deadline
+    // heapIndex[slot] is the slot's position in deadlineHeap (-1 = not queued)
+    int deadlineHeap[SMS_CONCAT_SLOTS];
+    int heapIndex[SMS_CONCAT_SLOTS];
+    int heapSize = 0;
+
+    int pendingExpired = -1;  // Slot handed out by nextExpired()
+    SmsFlushedKey flushed[SMS_CONCAT_FLUSHED_KEYS];
+    int flushedNext = 0;      // Ring position of the next flushed key
 
     // Static storage for returned result (avoids heap allocation)
     static SmsMessage resultBuffer;
+
+    // Slot lookup: probing starts at the key's home slot
+    static uint32_t keyHash(const SmsMessage& sms);
+    template <typename Entry>
+    static bool keyMatches(const Entry& entry, uint32_t hash, const SmsMessage& sms);
+    int homeSlot(uint32_t hash) const { return hash % SMS_CONCAT_SLOTS; }
+    int findSlot(uint32_t hash, const SmsMessage& sms) const;
+    int allocateSlot(uint32_t hash, const SmsMessage& sms);
+    void releaseSlot(int slot);
+    void storePart(int slot, const SmsMessage& sms);
+    bool isComplete(int slot) const { return slots[slot].receivedCount == slots[slot].totalParts; }
+    void buildResult(const SmsReassemblySlot& buffer);
+    int findFlushed(uint32_t hash, const SmsMessage& sms) const;
+    void rememberFlushed(const SmsReassemblySlot& buffer);
+
+    static unsigned long timeoutFor(SenderClass senderClass);
+
+    // Journal
+    void restoreFromJournal();
+    void journalRelease(int slot);
+    void compactJournal();
+    int findOrphan(uint32_t hash, const SmsMessage& sms) const;
+    bool addOrphan(uint32_t hash, const SmsMessage& sms);
+    SmsMessage slotPart(int slot, int partIndex) const;
+
+    // Deadline heap (wrap-safe millis() ordering)
+    bool dueBefore(int a, int b) const { return (long)(slots[a].deadline - slots[b].deadline) < 0; }
+    void heapPush(int slot);
+    void heapRemove(int slot);
+    void heapSwap(int i, int j);
+    void siftUp(int i);
+    void siftDown(int i);
 };
 
 #endif // SMS_CONCATENATOR_H
@@ -0,0 +1,75 @@
+#ifndef SMS_JOURNAL_H
+#define SMS_JOURNAL_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include "config.h"
+#include "sms_types.h"
+
+// Journal record layout
+namespace JournalConst {
+    constexpr uint8_t MAGIC = 0xA7;
+    constexpr int HEADER_SIZE = 8;          // magic, type, payload length (2), CRC-32 (4)
+    constexpr int MAX_PAYLOAD = 600;        // Part key (8) + sender, timestamp, text (3 × (2 + len))
+    constexpr int MAX_TEXT = 153 * 3;       // One part's UTF-8 text (matches the reassembly slot)
+    constexpr int MAX_FIELD = 40;           // Sender / timestamp
+}
+
+// Record types
+enum class SmsJournalRecord : uint8_t {
+    PART = 1,      // One buffered part of a multi-part message
+    RELEASE = 2    // Every earlier part with this key is no longer needed
+};
+
+// Append-only log of buffered multi-part SMS parts on LittleFS
+// Parts are journaled before they are deleted from the SIM so a reset
+// doesn't lose them. Appends collect in a RAM batch; flush() writes the
+// batch with one write + fsync. Each record carries a CRC-32, so a torn
+// write at the tail ends replay instead of corrupting it; init() then
+// truncates the log to the records before it.
+class SmsJournal {
+public:
+    SmsJournal();
+
+    // Mount LittleFS (formatting it on first use)
+    // A log damaged by a reset mid-write is cut at the last readable record
+    bool init();
+
+    // Queue a record in the RAM batch (written by flush())
+    bool appendPart(const SmsMessage& part);
+    bool appendRelease(const SmsMessage& key);  // Uses sender + partInfo ref/width/total
+
+    // Write the batch and fsync
+    bool flush();
+
+    // Bytes on flash (excluding the unflushed batch)
+    size_t size() const { return fileSize; }
+
+    // Read records back in write order
+    bool openReplay();
+    bool nextRecord(SmsJournalRecord& type, SmsMessage& out);
+    void closeReplay();
+
+    // Replace the log with the records appended between begin and commit
+    bool beginRewrite();
+    bool commitRewrite();
+
+private:
+    bool mounted;
+    bool rewriting;
+    size_t fileSize;
+    File replayFile;
+
+    // Pending records
+    static uint8_t batch[SMS_JOURNAL_BATCH_BYTES];
+    size_t batchLength;
+
+    const char* targetPath() const { return rewriting ? SMS_JOURNAL_REWRITE_PATH : SMS_JOURNAL_PATH; }
+    size_t replayableLength();
+    bool truncate(size_t length);
+    bool appendRecord(SmsJournalRecord type, const uint8_t* payload, int length);
+    static int putString(uint8_t* out, int pos, const String& value, int maxLength);
+    static bool getString(const uint8_t* in, int length, int& pos, String& value);
+};
+
+#endif // SMS_JOURNAL_H
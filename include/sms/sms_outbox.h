@@ -0,0 +1,55 @@
+#ifndef SMS_OUTBOX_H
+#define SMS_OUTBOX_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "sms_types.h"
+
+// One message waiting for the uplink
+struct SmsOutboxEntry {
+    SmsMessage message;     // Complete, partial or amendment message
+    int simIndex;           // Index of the part that completed it (-1 = none)
+    uint64_t fingerprint;   // Of that part, remembered once the server accepts it
+    SmsLane lane;
+    uint32_t readAt;        // millis() when its PDU came off the modem (lane latency)
+    uint8_t attempts;       // POSTs so far (the uplink gives up after SMS_SEND_ATTEMPTS)
+    bool expired;           // From SmsConcatenator::nextExpired(): report with completeExpired()
+    bool delivered;         // Set by the uplink before handing the entry back
+    bool inUse;
+
+    SmsOutboxEntry() : simIndex(-1), fingerprint(0), lane(SmsLane::BULK), readAt(0),
+                       attempts(0), expired(false), delivered(false), inUse(false) {}
+};
+
+// Fixed pool of entries lent to the uplink task
+// The priority lane overtakes bulk, so entries come back in any order and
+// are released individually. The last SMS_OUTBOX_PRIORITY_RESERVE entries
+// are kept for the priority lane, so a bulk backlog can't lock a code out.
+// Owned by the decode task; the uplink only reads the message and sets delivered.
+class SmsOutbox {
+public:
+    SmsOutbox() : count(0), bulkCount(0) {}
+
+    // nullptr only when every entry is lent out; callers keep bulk out of
+    // the reserve with room(SmsLane::BULK)
+    SmsOutboxEntry* push(const SmsMessage& message, int simIndex, uint64_t fingerprint, SmsLane lane,
+                         bool expired = false);
+    void release(SmsOutboxEntry* entry);
+
+    // A message with this fingerprint is already queued
+    bool contains(uint64_t fingerprint) const;
+
+    // The reassembled message with this key is already queued
+    bool containsReassembled(const SmsMessage& sms) const;
+
+    int size() const { return count; }
+    int room(SmsLane lane) const;
+    bool empty() const { return count == 0; }
+
+private:
+    SmsOutboxEntry entries[SMS_OUTBOX_CAPACITY];
+    int count;
+    int bulkCount;
+};
+
+#endif // SMS_OUTBOX_H
@@ -3,27 +3,64 @@
 
 #include <Arduino.h>
 
+// Sender address class (from Type of Address and digit count)
+enum class SenderClass : uint8_t {
+    PHONE,          // Regular subscriber number
+    SHORT_CODE,     // Numeric service number (few digits)
+    ALPHANUMERIC    // Text sender name ("Google", "MegaFon")
+};
+
 // Multi-part SMS metadata (extracted from UDH)
 struct SmsPartInfo {
     bool isMultiPart;      // True if this is part of a concatenated SMS
     uint16_t refNumber;    // Reference number (same for all parts)
+    bool ref16Bit;         // Reference came from the 16-bit IE (0x08)
     uint8_t totalParts;    // Total number of parts
     uint8_t partNumber;    // This part's number (1-based)
 
-    SmsPartInfo() : isMultiPart(false), refNumber(0), totalParts(1), partNumber(1) {}
+    SmsPartInfo() : isMultiPart(false), refNumber(0), ref16Bit(false), totalParts(1), partNumber(1) {}
+};
+
+// How complete a delivered message is (set by SmsConcatenator)
+enum class SmsDelivery : uint8_t {
+    COMPLETE,       // Single-part, or every part reassembled
+    PARTIAL,        // Reassembly timed out: text has gap markers for missing parts
+    AMENDMENT       // Late part of a message already delivered as PARTIAL
 };
 
+// Uplink lane (set by SmsClassifier)
+enum class SmsLane : uint8_t {
+    BULK,           // Everything else, in arrival order
+    PRIORITY        // One-time codes and configured senders: overtake the bulk backlog
+};
+
+constexpr int SMS_PART_MASK_WORDS = 8;  // 255 parts, one bit each
+constexpr int SMS_INDEX_DIRECT = 0x7FFF; // Delivered straight to us (+CMT), not stored on the SIM
+
 // Complete SMS message (after PDU parsing and decoding)
 struct SmsMessage {
     int index;             // SMS index in SIM memory (-1 = invalid)
     String sender;         // Sender phone number or alphanumeric name (UTF-8)
+    SenderClass senderClass;
     String text;           // Message text (UTF-8 decoded)
     String timestamp;      // Date and time from SMS (YYYY-MM-DD HH:MM:SS)
     SmsPartInfo partInfo;  // Multi-part SMS metadata
 
-    SmsMessage() : index(-1) {}
+    // Reassembly outcome; for PARTIAL, partInfo keeps refNumber/totalParts
+    // and for AMENDMENT it describes the late part
+    SmsDelivery delivery;
+    uint8_t partsReceived;                        // PARTIAL: parts present in text
+    uint32_t partsMissing[SMS_PART_MASK_WORDS];   // PARTIAL: bit (n-1) set = part n missing
+
+    SmsMessage() : index(-1), senderClass(SenderClass::PHONE), delivery(SmsDelivery::COMPLETE),
+                   partsReceived(0), partsMissing() {}
 
     bool isValid() const { return index >= 0; }
+    bool isOnSim() const { return index >= 0 && index != SMS_INDEX_DIRECT; }
+    bool isPartMissing(int partNumber) const {
+        int bit = partNumber - 1;
+        return (partsMissing[bit / 32] >> (bit % 32)) & 1;
+    }
 };
 
 #endif // SMS_TYPES_H
@@ -2,18 +2,26 @@
 #define TEXT_DECODER_H
 
 #include <Arduino.h>
+#include "gsm7_tables.h"
 
 // GSM 7-bit constants
 namespace Gsm7Const {
     constexpr uint8_t ESCAPE = 0x1B;    // Escape character for extended table
     constexpr uint8_t MASK_7BIT = 0x7F; // Mask for 7-bit character
+    constexpr int MAX_SEPTETS = 160;    // Septets in one User Data field
+    constexpr int MAX_UTF8_PER_SEPTET = 3; // Worst-case UTF-8 bytes per septet
 }
 
-// GSM 7-bit extended character mapping
-struct Gsm7ExtendedChar {
-    uint8_t code;
-    const char* replacement;
-};
+// UCS-2 constants
+namespace Ucs2Const {
+    constexpr uint16_t BOM = 0xFEFF;             // Byte Order Mark
+    constexpr uint16_t BOM_SWAPPED = 0xFFFE;     // Byte Order Mark, other endianness
+    constexpr uint16_t HIGH_SURROGATE = 0xD800;  // D800-DBFF: first half of a pair
+    constexpr uint16_t LOW_SURROGATE = 0xDC00;   // DC00-DFFF: second half of a pair
+    constexpr uint16_t SURROGATE_END = 0xE000;
+    constexpr uint16_t REPLACEMENT = 0xFFFD;     // Emitted for unpaired surrogates
+    constexpr int STACK_OUTPUT = 256;            // Covers a full 140-octet UD (max 210 bytes)
+}
 
 // Pure functions for text encoding/decoding
 class TextDecoder {
@@ -22,7 +30,15 @@ public:
     // - data: byte array containing packed 7-bit characters
     // - charCount: number of characters to decode
     // - paddingBits: bit offset for text after UDH (0-6)
-    static String decodeGsm7bit(const uint8_t* data, int charCount, int paddingBits = 0);
+    // - shift: national language tables from the UDH (default alphabet if omitted)
+    static String decodeGsm7bit(const uint8_t* data, int charCount, int paddingBits = 0,
+                                const Gsm7Shift& shift = Gsm7Shift());
+
+    // GSM 7-bit → UTF-8 into a caller buffer, no allocation
+    // - out: at least charCount * MAX_UTF8_PER_SEPTET bytes
+    // Returns number of bytes written (not NUL-terminated)
+    static size_t decodeGsm7bitTo(const uint8_t* data, int charCount, int paddingBits, char* out,
+                                  const Gsm7Shift& shift = Gsm7Shift());
 
     // UCS-2 (16-bit Unicode) → UTF-8
     // - data: byte array containing UCS-2 big-endian characters
@@ -30,13 +46,15 @@ public:
     // Supports surrogate pairs for emoji
     static String decodeUcs2(const uint8_t* data, int byteCount);
 
+    // Exact UTF-8 size of a UCS-2 buffer (first pass of decodeUcs2)
+    static size_t ucs2Utf8Length(const uint8_t* data, int byteCount);
+
+    // UCS-2 → UTF-8 into a caller buffer of ucs2Utf8Length() bytes
+    // Returns number of bytes written (not NUL-terminated)
+    static size_t decodeUcs2To(const uint8_t* data, int byteCount, char* out);
+
     // Legacy: UCS-2 hex string → UTF-8 (for compatibility)
     static String decodeUcs2Hex(const String& hexStr);
-
-private:
-    // GSM 7-bit alphabet tables (UTF-8 strings for multi-byte chars)
-    static const char* const GSM7_BASIC[128];
-    static const Gsm7ExtendedChar GSM7_EXTENDED[10];
 };
 
 #endif // TEXT_DECODER_H
@@ -0,0 +1,53 @@
+#ifndef TEXT_ENCODER_H
+#define TEXT_ENCODER_H
+
+#include <Arduino.h>
+
+// SMS segment sizes (3GPP TS 23.040)
+namespace SegmentConst {
+    constexpr int GSM7_SINGLE = 160;   // Septets in a single SMS
+    constexpr int GSM7_MULTI = 153;    // Septets per part (UDH takes 7)
+    constexpr int UCS2_SINGLE = 70;    // UTF-16 units in a single SMS
+    constexpr int UCS2_MULTI = 67;     // UTF-16 units per part (UDH takes 3)
+    constexpr int MAX_SEGMENTS = 255;  // Concatenation limit
+}
+
+enum class SmsEncoding : uint8_t {
+    GSM7,  // GSM 7-bit default alphabet (+ extension table)
+    UCS2   // UCS-2 / UTF-16 big-endian
+};
+
+// Result of TextEncoder::estimate()
+struct SegmentEstimate {
+    SmsEncoding encoding;  // Cheapest encoding that represents the text
+    int units;             // Septets (GSM7) or UTF-16 code units (UCS2)
+    int segments;          // Parts needed (0 for empty text)
+
+    SegmentEstimate() : encoding(SmsEncoding::GSM7), units(0), segments(0) {}
+};
+
+// UTF-8 → SMS encodings, counterpart of TextDecoder
+// Uses the same GSM 7-bit tables, so encode → decode round-trips exactly
+class TextEncoder {
+public:
+    // Pick GSM7 when every character is representable, UCS2 otherwise,
+    // and count segments without producing any encoded bytes
+    // Escape pairs and surrogate pairs are never split across parts
+    static SegmentEstimate estimate(const char* utf8, size_t len);
+    static SegmentEstimate estimate(const String& text);
+
+    // True if every character has a GSM 7-bit representation
+    static bool isGsm7Compatible(const char* utf8, size_t len);
+
+    // UTF-8 → packed GSM 7-bit
+    // - paddingBits: leading fill bits when text follows a UDH (0-6)
+    // Returns septet count, or -1 if unrepresentable or out doesn't fit
+    static int encodeGsm7bit(const char* utf8, size_t len, uint8_t* out, size_t outCap,
+                              int paddingBits = 0);
+
+    // UTF-8 → UCS-2 big-endian (supplementary characters as surrogate pairs)
+    // Returns byte count, or -1 if out doesn't fit
+    static int encodeUcs2(const char* utf8, size_t len, uint8_t* out, size_t outCap);
+};
+
+#endif // TEXT_ENCODER_H
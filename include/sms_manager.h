@@ -5,6 +5,8 @@
 #include "config.h"
 #include <TinyGsmClient.h>
 #include "sms/sms_types.h"
+#include "sms/pdu_parser.h"
+#include "sms/pdu_stream_parser.h"
 
 // AT+CMGL status codes (PDU mode)
 namespace SmsStatus {
@@ -15,6 +17,19 @@ namespace SmsStatus {
     constexpr int ALL = 4;         // All messages
 }
 
+// AT+CMGD=<index>,<delflag>
+namespace SmsDeleteFlag {
+    constexpr int INDEX = 0;       // Only the given index
+    constexpr int ALL_READ = 1;    // Every REC READ message (index ignored)
+}
+
+// Batch delete limits
+namespace SmsDeleteConst {
+    constexpr int MAX_INDEX = 255;          // Indices tracked from the last listing (and in flight)
+    constexpr int MASK_WORDS = (MAX_INDEX + 32) / 32;
+    constexpr int CHAIN_LENGTH = 8;         // AT+CMGD commands chained on one command line
+}
+
 // SMS management via AT commands
 class SmsManager {
 public:
@@ -23,21 +38,135 @@ public:
     // Initialize SMS subsystem (set PDU mode)
     bool init();
 
-    // Check if any SMS messages exist
-    bool hasNewSms();
+    // Read the next page of the inbox in a single AT+CMGL transaction
+    // PDU hex is converted to octets while the response streams in from the
+    // UART; decoding is left to the caller (PduParser::parseBytes)
+    // Fills up to maxCount PDUs after the paging cursor, skipping malformed
+    // lines and indices already handed out. Handed-out indices are marked in
+    // flight until setInFlight(index, false) or a delete. hasMorePages() is
+    // true while the pass has messages left; the next pass starts from the top
+    // A pass lists only REC UNREAD, so idle polls move only new PDUs; the
+    // first pass after boot or an inconsistency lists ALL and resyncs
+    bool readPage(SmsRawPdu* pdus, int maxCount, int& count);
+    bool hasMorePages() const { return pageCursor >= 0; }
 
-    // Get list of all SMS indices
-    bool getSmsList(int* indices, int maxCount, int& count);
+    // An index handed out by readPage() and still in the pipeline: skipped
+    // even by a full rescan so a queued message isn't decoded twice
+    void setInFlight(int index, bool inFlight);
 
-    // Read SMS by index (returns parsed SmsMessage)
-    SmsMessage readSms(int index);
+    // An index handed out by readPage() came back unconsumed: it stays on the
+    // SIM, now REC READ, so the next pass lists ALL and hands it out again
+    void release(int index);
 
     // Delete SMS by index
     bool deleteSms(int index);
 
+    // Delete several SMS; deleted[i] reports the outcome for indices[i]
+    // When the batch covers every message known to be read, one
+    // AT+CMGD=<i>,1 removes them all (listed messages are REC READ, anything
+    // newer is still unread). Otherwise deletes are chained on command lines.
+    // A failed delete forces a full rescan so the message is picked up again
+    // Returns the number deleted
+    int deleteBatch(const int* indices, int count, bool* deleted);
+
+    // Message storage (AT+CPMS): slots used / total in the receive storage
+    // Counted by readPage() and the deletes, re-queried by refreshStorage()
+    // (a count that keeps disagreeing with the bookkeeping forces a full rescan)
+    bool refreshStorage();
+    int getStorageUsed() const { return storageUsed; }
+    int getStorageTotal() const { return storageTotal; }
+
+    // Storage (nearly) full: the network stops delivering until slots are
+    // freed, so scan back to back and delete each SMS as soon as it's sent
+    bool isDraining() const {
+        return storageFull || (storageTotal > 0 && storageTotal - storageUsed <= SMS_STORAGE_DRAIN_FREE);
+    }
+
+    // New-message signalling: drains +CMTI URCs waiting on the UART and the
+    // RING pin flag. True when new SMS may be waiting (call between AT commands)
+    bool pollArrivals();
+
+    // Modem bytes left unread by pollArrivals() (it stops after a +CMT PDU)
+    bool hasPendingInput() { return modem.stream.available() > 0; }
+
+    // Direct delivery (SMS_DIRECT_DELIVERY): a +CMT PDU received by pollArrivals()
+    // The modem sends no further +CMT until acknowledge() is called
+    // A malformed PDU comes back with length 0
+    bool takeDirectPdu(SmsRawPdu& out);
+
+    // Write a +CMT PDU to the receive storage (AT+CMGW) before it's
+    // acknowledged, so a failed send or a reset recovers it from there
+    // The new index is marked in flight, as if handed out by readPage()
+    // False if it couldn't be stored within SMS_DIRECT_ACK_TIMEOUT
+    bool storeDirectPdu(const SmsRawPdu& raw, int& index);
+
+    // Answer the network for the +CMT message: accepted → RP-ACK,
+    // otherwise RP-ERROR so the SMSC keeps it and retries later
+    bool acknowledge(bool accepted);
+
+    // Debug dump of a parsed message
+    static void printSms(const SmsMessage& sms);
+
 private:
     TinyGsm& modem;
     bool initialized;
+    bool arrivalPending;  // +CMTI seen (or listing cut short) since the last poll
+    char urcLine[64];     // Partial URC line between polls
+    int urcLength;
+    bool directPdu;       // Receiving the PDU line after a +CMT header
+    bool directReady;     // directRaw holds an unacknowledged +CMT PDU
+    SmsRawPdu directRaw;
+
+    // Receive storage state
+    const char* storageName;
+    int storageUsed;
+    int storageTotal;
+    bool storageFull;     // Memory-full URC seen since the last refresh showed free slots
+
+    // Select SMS_STORAGE_PREFERRED (or the fallback) for read, write and receive
+    bool selectStorage();
+
+    // Take <used>,<total> of the receive storage from a +CPMS response
+    bool parseStorage(const String& response);
+    void setStorageUsed(int used);  // Also ends drain mode once there's room
+
+    // Read-state bookkeeping, one bit per storage index
+    // Listing marks messages REC READ, so after a full scan readMask is
+    // every message on the SIM and later scans only need REC UNREAD
+    uint32_t readMask[SmsDeleteConst::MASK_WORDS];      // Listed, not yet deleted
+    uint32_t seenMask[SmsDeleteConst::MASK_WORDS];      // Handed out by readPage()
+    uint32_t inFlightMask[SmsDeleteConst::MASK_WORDS];  // Handed out and queued
+    uint32_t retryMask[SmsDeleteConst::MASK_WORDS];     // Released unconsumed, read again next pass
+    bool untracked;       // An index above MAX_INDEX is on the SIM
+    bool fullScanNeeded;  // Boot, or the bookkeeping no longer matches the SIM
+    int storageMismatch;  // Consecutive +CPMS counts that disagree with readMask
+
+    // Paging state
+    int pageCursor;       // Last index of the previous page (-1 = pass complete)
+
+    static bool testBit(const uint32_t* mask, int index) {
+        return index >= 0 && index <= SmsDeleteConst::MAX_INDEX && (mask[index / 32] & (1UL << (index % 32))) != 0;
+    }
+    static void setBit(uint32_t* mask, int index, bool value);
+    static int countBits(const uint32_t* mask);
+
+    // RING pin pulse (set from the GPIO interrupt)
+    static volatile bool ringFlag;
+    static void IRAM_ATTR onRing();
+
+    // Enable +CMTI indications and the RING pin
+    void enableArrivalIndications();
+
+    // Route new SMS to us as +CMT (after init, and whenever the ME dropped
+    // the routing because an acknowledgement came too late)
+    bool routeDirectSms();
+
+    // Recognize a new-message URC line
+    bool handleUrc(const char* line);
+
+    // Feed the PDU line of a +CMT; true once the line is complete
+    bool feedDirectPdu(char c);
+    PduStreamParser pduStream;  // Incremental parser for listed PDUs
 };
 
 #endif // SMS_MANAGER_H
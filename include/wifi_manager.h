@@ -6,6 +6,8 @@
 
 class WiFiManager {
 public:
+    static const unsigned long RECONNECT_INTERVAL = 10000; // 10 seconds between reconnect attempts
+
     // Initialize and connect to WiFi
     bool connect();
 
@@ -15,6 +17,9 @@ public:
     // Attempt to reconnect if disconnected
     void reconnect();
 
+    // Mirror connection state into EventBit::WIFI_UP / WIFI_LOST
+    void watchEvents();
+
     // Get current signal strength
     int getRSSI();
 
@@ -22,8 +27,9 @@ public:
     String getLocalIP();
 
 private:
+    static void onWiFiEvent(arduino_event_id_t event);
+
     unsigned long lastReconnectAttempt = 0;
-    static const unsigned long RECONNECT_INTERVAL = 10000; // 10 seconds between reconnect attempts
 };
 
 #endif // WIFI_MANAGER_H
\ No newline at end of file
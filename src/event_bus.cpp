@@ -0,0 +1,46 @@
+#include "event_bus.h"
+
+EventGroupHandle_t EventBus::group = nullptr;
+
+bool EventBus::init() {
+    group = xEventGroupCreate();
+    return group != nullptr;
+}
+
+void EventBus::signal(EventBits_t bits) {
+    if (group != nullptr) {
+        xEventGroupSetBits(group, bits);
+    }
+}
+
+void IRAM_ATTR EventBus::signalFromIsr(EventBits_t bits) {
+    if (group == nullptr) {
+        return;
+    }
+    // Deferred to the timer task; the caller keeps its own flag in case that fails
+    BaseType_t woken = pdFALSE;
+    if (xEventGroupSetBitsFromISR(group, bits, &woken) == pdPASS && woken == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+void EventBus::clear(EventBits_t bits) {
+    xEventGroupClearBits(group, bits);
+}
+
+bool EventBus::isSet(EventBits_t bits) {
+    return (xEventGroupGetBits(group) & bits) != 0;
+}
+
+EventBits_t EventBus::wait(EventBits_t bits, TickType_t timeout) {
+    return xEventGroupWaitBits(group, bits, pdTRUE, pdFALSE, timeout) & bits;
+}
+
+bool EventBus::waitLevel(EventBits_t bit, TickType_t timeout) {
+    return (xEventGroupWaitBits(group, bit, pdFALSE, pdTRUE, timeout) & bit) != 0;
+}
+
+TickType_t EventBus::ticksUntil(unsigned long deadline) {
+    long remaining = (long)(deadline - millis());
+    return remaining <= 0 ? 0 : pdMS_TO_TICKS(remaining);
+}
@@ -3,6 +3,7 @@
 HttpSender::HttpSender() : lastStatusCode(0) {}
 
 bool HttpSender::sendSmsToServer(const SmsMessage& sms) {
+    lastStatusCode = 0;
     if (!sms.isValid()) {
         lastError = "Invalid SMS message";
         DEBUG_PRINTLN("ERROR: Invalid SMS message");
@@ -89,6 +90,25 @@ String HttpSender::createJsonPayload(const SmsMessage& sms) {
     doc["text"] = sms.text;
     doc["timestamp"] = sms.timestamp;
 
+    // Multi-part reassembly that didn't complete
+    if (sms.delivery == SmsDelivery::PARTIAL) {
+        doc["partial"] = true;
+        doc["ref"] = sms.partInfo.refNumber;
+        doc["parts_total"] = sms.partInfo.totalParts;
+        doc["parts_received"] = sms.partsReceived;
+        JsonArray missing = doc["parts_missing"].to<JsonArray>();
+        for (int part = 1; part <= sms.partInfo.totalParts; part++) {
+            if (sms.isPartMissing(part)) {
+                missing.add(part);
+            }
+        }
+    } else if (sms.delivery == SmsDelivery::AMENDMENT) {
+        doc["amendment"] = true;
+        doc["ref"] = sms.partInfo.refNumber;
+        doc["parts_total"] = sms.partInfo.totalParts;
+        doc["part"] = sms.partInfo.partNumber;
+    }
+
     // Serialize to string
     String output;
     serializeJson(doc, output);
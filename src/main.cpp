@@ -1,23 +1,157 @@
 #include <Arduino.h>
+#include <memory>
+#include <vector>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
 #include "config.h"
 #include "utilities.h"
+#include "event_bus.h"
 #include "modem_manager.h"
 #include "wifi_manager.h"
 #include "sms_manager.h"
 #include "http_sender.h"
+#include "sms/pdu_parser.h"
 #include "sms/sms_concatenator.h"
+#include "sms/duplicate_filter.h"
+#include "sms/sms_outbox.h"
+#include "sms/sms_classifier.h"
+
+// Light sleep needs power management in the ESP-IDF build; +CMT PDUs can't
+// afford the bytes lost while the UART wakes the chip
+#define LIGHT_SLEEP_ACTIVE (CONFIG_PM_ENABLE && POWER_LIGHT_SLEEP && !SMS_DIRECT_DELIVERY)
+#if LIGHT_SLEEP_ACTIVE
+#include <esp_pm.h>
+#include <esp_sleep.h>
+#include <driver/gpio.h>
+#include <driver/uart.h>
+#endif
+
+// Outcome for one index handed out by the modem task
+struct SmsSlotDone {
+    int16_t index;      // Storage index
+    bool consumed;      // Delivered, journaled or duplicate: delete it
+};
+
+// Bounded queue between two pipeline stages, with its peak depth for the status report
+// Sending and receiving raise event bits, so the task on the other side
+// wakes instead of polling the queue
+struct StageQueue {
+    const char* name;
+    QueueHandle_t handle;
+    UBaseType_t length;
+    volatile UBaseType_t peak;
+    EventBits_t sentBit;      // Raised after an item is queued
+    EventBits_t receivedBit;  // Raised after an item is taken
+
+    bool create(const char* queueName, UBaseType_t queueLength, UBaseType_t itemSize,
+                EventBits_t onSend, EventBits_t onReceive) {
+        name = queueName;
+        length = queueLength;
+        peak = 0;
+        sentBit = onSend;
+        receivedBit = onReceive;
+        handle = xQueueCreate(queueLength, itemSize);
+        return handle != nullptr;
+    }
+
+    bool send(const void* item, TickType_t wait) {
+        if (xQueueSend(handle, item, wait) != pdTRUE) {
+            return false;
+        }
+        UBaseType_t depth = uxQueueMessagesWaiting(handle);
+        if (depth > peak) {
+            peak = depth;
+        }
+        if (sentBit != 0) {
+            EventBus::signal(sentBit);
+        }
+        return true;
+    }
+
+    bool receive(void* item, TickType_t wait) {
+        if (xQueueReceive(handle, item, wait) != pdTRUE) {
+            return false;
+        }
+        if (receivedBit != 0) {
+            EventBus::signal(receivedBit);
+        }
+        return true;
+    }
+
+    UBaseType_t depth() const { return uxQueueMessagesWaiting(handle); }
+    UBaseType_t space() const { return uxQueueSpacesAvailable(handle); }
+};
+
+// Delivery latency of one uplink lane: PDU read → accepted by the server
+struct LaneStats {
+    const char* name;
+    uint32_t delivered;
+    uint64_t totalMs;
+    uint32_t maxMs;
+
+    void record(uint32_t ms) {
+        delivered++;
+        totalMs += ms;
+        if (ms > maxMs) {
+            maxMs = ms;
+        }
+    }
+};
+
+// Counters for the status report, each written by the task that owns it.
+// loop() runs beside those tasks (totalMs isn't even one store), so writes
+// and the report's copy both go through statsMux
+struct PipelineStats {
+    LaneStats lanes[2];        // Indexed by SmsLane (decode task)
+    uint32_t pagingThrottled;  // Scans held back by a full pipeline (modem task)
+    uint32_t duplicates;       // Published from duplicateFilter (decode task)
+    uint32_t collisions;       // Published from smsConcatenator (decode task)
+};
 
 // Global objects
 ModemManager modemManager;  // For SMS operations via LTE modem
 WiFiManager wifiManager;    // For HTTP operations via ESP32 WiFi
-SmsManager* smsManager = nullptr;
-HttpSender* httpSender = nullptr;
-SmsConcatenator smsConcatenator;  // Multi-part SMS handler
+SmsManager* smsManager = nullptr;  // Modem task
+HttpSender* httpSender = nullptr;  // Uplink task
+SmsConcatenator smsConcatenator;  // Multi-part SMS handler (decode task)
+SmsJournal smsJournal;            // Flash log of buffered parts (decode task)
+DuplicateFilter duplicateFilter;  // Fingerprints of SMS already handled (decode task)
+SmsOutbox smsOutbox;              // Entries lent to the uplink (decode task)
+
+// Pipeline: modem task → decode task → uplink task, outcomes flow back
+StageQueue rawQueue;     // SmsRawPdu: framed PDUs to decode
+StageQueue uplinkQueue;  // SmsOutboxEntry*: bulk messages to send
+StageQueue fastQueue;    // SmsOutboxEntry*: priority messages, sent ahead of bulk
+StageQueue resultQueue;  // SmsOutboxEntry*: sent (or given up), back to the decode task
+StageQueue doneQueue;    // SmsSlotDone: indices to delete, release or acknowledge
+StageQueue parkedQueue;  // SmsRawPdu: PDUs waiting for bulk room or a reassembly slot (decode task only)
+constexpr int DONE_QUEUE_LENGTH = SMS_OUTBOX_CAPACITY + 3 * SMS_INBOX_PAGE_SIZE;
+
+// Modem task state
+std::vector<int> consumedIndices;  // Consumed SMS still on the SIM (deleted in batches)
+unsigned long nextSmsScan = 0;     // Safety-net scan time
+unsigned long nextStorageCheck = 0;
+bool inboxPending = false;         // New SMS signalled, not yet paged in
+#if LIGHT_SLEEP_ACTIVE
+esp_pm_lock_handle_t modemAwake = nullptr;  // Held while the modem task runs
+#endif
+
+// Decode task state
+struct PendingPart {
+    int16_t index;
+    uint64_t fingerprint;
+};
+std::vector<PendingPart> pendingParts;  // Buffered parts waiting for the journal flush
+bool partialOutstanding = false;        // An expired message is with the uplink
 
-// Timing variables
-unsigned long lastSmsCheck = 0;
-unsigned long lastNetworkCheck = 0;
-unsigned long lastCleanup = 0;
+// Status report counters (any task, under statsMux)
+PipelineStats pipelineStats = { { { "Bulk", 0, 0, 0 }, { "Priority", 0, 0, 0 } }, 0, 0, 0 };
+portMUX_TYPE statsMux = portMUX_INITIALIZER_UNLOCKED;
+
+bool startPipeline();
+void enableLightSleep();
+void reportPipeline();
 
 void setup() {
     // Initialize serial monitor
@@ -53,6 +187,14 @@ void setup() {
 
     // Initialize SMS manager
     DEBUG_PRINTLN("Step 3: Initializing SMS manager...");
+    // The event group first: the RING interrupt signals it from here on
+    if (!EventBus::init()) {
+        DEBUG_PRINTLN("FATAL ERROR: Event group allocation failed!");
+        DEBUG_PRINTLN("System halted. Please restart the device.");
+        while (true) {
+            delay(1000);
+        }
+    }
     smsManager = new SmsManager(modemManager.getModem());
     if (!smsManager->init()) {
         DEBUG_PRINTLN("FATAL ERROR: SMS manager initialization failed!");
@@ -63,118 +205,655 @@ void setup() {
     }
     DEBUG_PRINTLN();
 
+    // Allocate multi-part reassembly pool, restoring parts buffered before a reset
+    DEBUG_PRINTLN("Step 4: Initializing multi-part buffer...");
+    SmsJournal* journal = nullptr;
+#if SMS_JOURNAL_ENABLED
+    if (smsJournal.init()) {
+        journal = &smsJournal;
+    } else {
+        DEBUG_PRINTLN("WARNING: Multi-part journal unavailable, parts are kept in RAM only");
+    }
+#endif
+#if SMS_DEDUP_ENABLED
+    duplicateFilter.init();
+#endif
+    if (!smsConcatenator.init(journal)) {
+        DEBUG_PRINTLN("FATAL ERROR: Multi-part buffer allocation failed!");
+        DEBUG_PRINTLN("System halted. Please restart the device.");
+        while (true) {
+            delay(1000);
+        }
+    }
+    DEBUG_PRINTLN();
+
     // Initialize HTTP sender (uses WiFi, not modem)
-    DEBUG_PRINTLN("Step 4: Initializing HTTP sender...");
+    DEBUG_PRINTLN("Step 5: Initializing HTTP sender...");
     httpSender = new HttpSender();
     DEBUG_PRINTLN("HTTP sender initialized (WiFi)");
     DEBUG_PRINTLN();
 
+    // Hand the modem, decoder and uplink to their own tasks
+    DEBUG_PRINTLN("Step 6: Starting SMS pipeline...");
+    if (!startPipeline()) {
+        DEBUG_PRINTLN("FATAL ERROR: SMS pipeline start failed!");
+        DEBUG_PRINTLN("System halted. Please restart the device.");
+        while (true) {
+            delay(1000);
+        }
+    }
+    DEBUG_PRINTLN("Modem and decode tasks on core 1, uplink on core 0");
+    DEBUG_PRINTLN();
+
     DEBUG_PRINTLN("========================================");
     DEBUG_PRINTLN("   System Ready - Monitoring SMS...");
     DEBUG_PRINTLN("========================================");
     DEBUG_PRINTLN();
 }
 
-void loop() {
-    unsigned long currentMillis = millis();
+// ---------------------------------------------------------------------------
+// Modem task: every AT command goes through here (paging, deletes, +CNMA)
+// ---------------------------------------------------------------------------
 
-    // Check WiFi connection periodically
-    if (currentMillis - lastNetworkCheck >= NETWORK_CHECK_INTERVAL) {
-        lastNetworkCheck = currentMillis;
+#if SMS_DELETE_AFTER_SEND
+// Delete the given SIM indices in one batch and clear the list
+// Returns the number of slots freed
+int deleteFromSim(std::vector<int>& indices) {
+    if (indices.empty()) {
+        return 0;
+    }
 
-        if (!wifiManager.isConnected()) {
-            DEBUG_PRINTLN("WARNING: WiFi connection lost!");
-            wifiManager.reconnect();
+    std::unique_ptr<bool[]> deleted(new bool[indices.size()]);
+    int freed = smsManager->deleteBatch(indices.data(), indices.size(), deleted.get());
+    for (size_t i = 0; i < indices.size(); i++) {
+        if (deleted[i]) {
+            DEBUG_PRINTF("✓ SMS %d deleted from SIM\n", indices[i]);
+        } else {
+            DEBUG_PRINTF("✗ Failed to delete SMS %d from SIM\n", indices[i]);
         }
+        // Either way it may be listed again (a failed delete is retried
+        // through the duplicate filter)
+        smsManager->setInFlight(indices[i], false);
+    }
+    indices.clear();
+    return freed;
+}
+#endif
+
+// Apply an outcome from the pipeline to the SIM bookkeeping
+void applySlotDone(const SmsSlotDone& done) {
+#if SMS_DELETE_AFTER_SEND
+    if (done.consumed) {
+        consumedIndices.push_back(done.index);
+        return;
+    }
+#endif
+    if (done.consumed) {
+        smsManager->setInFlight(done.index, false);
+        return;
+    }
+
+    // Still on the SIM: read it again on a pass no later than the retry interval
+    smsManager->release(done.index);
+    unsigned long retryAt = millis() + SMS_RETRY_INTERVAL;
+    if ((long)(retryAt - nextSmsScan) < 0) {
+        nextSmsScan = retryAt;
+    }
+}
+
+#if SMS_DIRECT_DELIVERY
+// Store a +CMT PDU, answer the network, then hand it on like a listed SMS
+// RP-ACK as soon as the SIM holds a copy, well inside the network's TR2M
+// timer: from then on a failed send or a reset recovers it from storage,
+// as for any stored SMS. No room (or a garbled PDU line): RP-ERROR, the
+// SMSC keeps it and redelivers later
+void handleDirectPdu(SmsRawPdu& raw) {
+    int index;
+    bool stored = smsManager->storeDirectPdu(raw, index);
+    smsManager->acknowledge(stored);
+    if (!stored) {
+        return;
     }
 
-    // Clean up old partial multi-part SMS every 60 seconds
-    if (currentMillis - lastCleanup >= 60000) {
-        lastCleanup = currentMillis;
-        smsConcatenator.cleanup();
+    raw.index = index;
+    if (!rawQueue.send(&raw, 0)) {
+        // Decoder full: a later pass reads it from storage
+        smsManager->release(index);
+        inboxPending = true;
     }
+}
+#endif
+
+void modemTask(void* param) {
+    static SmsRawPdu page[SMS_INBOX_PAGE_SIZE];
+#if LIGHT_SLEEP_ACTIVE
+    esp_pm_lock_acquire(modemAwake);
+#endif
 
-    // Check for new SMS
-    if (currentMillis - lastSmsCheck >= SMS_CHECK_INTERVAL) {
-        lastSmsCheck = currentMillis;
+    while (true) {
+        unsigned long currentMillis = millis();
+
+        // Outcomes from the decode and uplink stages
+        SmsSlotDone done;
+        while (doneQueue.receive(&done, 0)) {
+            applySlotDone(done);
+        }
+
+#if SMS_DELETE_AFTER_SEND
+        // Deletes are batched until the pipeline goes idle; storage full
+        // frees each slot at once
+        bool pipelineIdle = rawQueue.depth() == 0 && parkedQueue.depth() == 0 &&
+                            uplinkQueue.depth() == 0 && fastQueue.depth() == 0;
+        if (!consumedIndices.empty() && (pipelineIdle || smsManager->isDraining() ||
+            consumedIndices.size() >= (size_t)SmsDeleteConst::CHAIN_LENGTH)) {
+            deleteFromSim(consumedIndices);
+        }
+#endif
 
-        // Get list of SMS
-        int indices[10]; // Maximum 10 SMS at once
-        int count = 0;
+        // New SMS: on a +CMTI URC or RING pulse, plus a slow safety-net scan
+        if (smsManager->pollArrivals()) {
+            inboxPending = true;
+        }
 
-        if (smsManager->getSmsList(indices, 10, count)) {
-            DEBUG_PRINTF("\n>>> Found %d SMS messages <<<\n\n", count);
+#if SMS_DIRECT_DELIVERY
+        SmsRawPdu directRaw;
+        if (smsManager->takeDirectPdu(directRaw)) {
+            handleDirectPdu(directRaw);
+        }
+#endif
 
-            // Track indices of parts to delete after successful send
-            std::vector<int> partsToDelete;
+        // Page through the inbox back to back while SMS remain, unless the
+        // uplink has fallen behind or the decoder hasn't caught up
+        bool scanDue = inboxPending || smsManager->hasMorePages() || (long)(currentMillis - nextSmsScan) >= 0;
+        bool throttled = uplinkQueue.depth() >= SMS_OUTBOX_HIGH_WATER || rawQueue.space() == 0;
+        if (scanDue && throttled) {
+            portENTER_CRITICAL(&statsMux);
+            pipelineStats.pagingThrottled++;
+            portEXIT_CRITICAL(&statsMux);
+        } else if (scanDue) {
+            inboxPending = false;
+            nextSmsScan = currentMillis + SMS_CHECK_INTERVAL;
 
-            // Process each SMS
+            // Never read more than the decode queue has room for
+            int pageSize = min(SMS_INBOX_PAGE_SIZE, (int)rawQueue.space());
+            int count = 0;
+            smsManager->readPage(page, pageSize, count);
             for (int i = 0; i < count; i++) {
-                DEBUG_PRINTF("--- Processing SMS %d/%d (Index: %d) ---\n", i + 1, count, indices[i]);
+                rawQueue.send(&page[i], portMAX_DELAY);
+            }
+        }
+
+        if ((long)(currentMillis - nextStorageCheck) >= 0) {
+            nextStorageCheck = currentMillis + NETWORK_CHECK_INTERVAL;
+            if (smsManager->refreshStorage()) {
+                DEBUG_PRINTF("SMS storage: %d/%d used\n",
+                    smsManager->getStorageUsed(), smsManager->getStorageTotal());
+            }
+        }
+
+        // Pages left (and room for them) or unread modem bytes: go on.
+        // Otherwise block until an event, or the scan / storage deadline
+        bool moreWork = (smsManager->hasMorePages() && !throttled) || smsManager->hasPendingInput();
+        if (!moreWork) {
+            unsigned long deadline = (long)(nextSmsScan - nextStorageCheck) < 0 ? nextSmsScan : nextStorageCheck;
+#if LIGHT_SLEEP_ACTIVE
+            esp_pm_lock_release(modemAwake);
+#endif
+            EventBus::wait(EventBit::MODEM_UART | EventBit::MODEM_RING | EventBit::SLOT_DONE |
+                           EventBit::PIPELINE_FREE, EventBus::ticksUntil(deadline));
+#if LIGHT_SLEEP_ACTIVE
+            esp_pm_lock_acquire(modemAwake);
+#endif
+        }
+    }
+}
 
-                // Read SMS
-                SmsMessage sms = smsManager->readSms(indices[i]);
+// ---------------------------------------------------------------------------
+// Decode task: PDU decoding, reassembly, journal and duplicate filter
+// ---------------------------------------------------------------------------
 
-                if (sms.isValid()) {
-                    // Add to concatenator (handles both single and multi-part SMS)
-                    SmsMessage* completeSms = smsConcatenator.addPart(sms);
+void postDone(int index, bool consumed) {
+    SmsSlotDone done = { (int16_t)index, consumed };
+    doneQueue.send(&done, portMAX_DELAY);
+}
 
-                    if (completeSms != nullptr) {
-                        // We have a complete message (either single-part or all parts received)
-                        DEBUG_PRINTLN("→ Sending complete message to server");
-                        bool sendSuccess = httpSender->sendSmsToServer(*completeSms);
+// Lend a message to the uplink on its lane (the caller checked smsOutbox.room())
+// False if every entry is lent out: nothing was queued
+bool queueForUplink(const SmsMessage& message, int simIndex, uint64_t fingerprint,
+                    SmsLane lane, uint32_t readAt, bool expired) {
+    SmsOutboxEntry* entry = smsOutbox.push(message, simIndex, fingerprint, lane, expired);
+    if (entry == nullptr) {
+        DEBUG_PRINTLN("ERROR: Outbox full, message not queued");
+        return false;
+    }
+    entry->readAt = readAt;
+    if (lane == SmsLane::PRIORITY) {
+        fastQueue.send(&entry, portMAX_DELAY);
+        DEBUG_PRINTF("→ Queued for the server on the priority lane (%d waiting)\n", smsOutbox.size());
+    } else {
+        uplinkQueue.send(&entry, portMAX_DELAY);
+        DEBUG_PRINTF("→ Queued for the server (%d waiting)\n", smsOutbox.size());
+    }
+    return true;
+}
 
-                        if (sendSuccess) {
-                            DEBUG_PRINTLN("✓ SMS successfully sent to server");
+// Decode one PDU: complete messages go to the uplink, buffered parts wait
+// for the journal flush before their SIM copy may go
+// A bulk SIM message finding no bulk room is parked instead, so the PDUs
+// behind it (a one-time code) are still decoded and can overtake it
+void decodePdu(const SmsRawPdu& raw, bool unparked = false) {
+    SmsMessage sms;
+    if (raw.length == 0 || !PduParser::parseBytes(raw.pdu, raw.length, sms)) {
+        // Decoding the same bytes again can't succeed: drop it (delete the
+        // SIM copy) rather than hold the slot forever
+        DEBUG_PRINTF("✗ Failed to decode SMS %d, dropping it\n", raw.index);
+        postDone(raw.index, true);
+        return;
+    }
+    sms.index = raw.index;
+    if (unparked) {
+        DEBUG_PRINTF("--- Resuming parked SMS (Index: %d) ---\n", sms.index);
+    } else {
+        DEBUG_PRINTF("--- Processing SMS (Index: %d) ---\n", sms.index);
+        SmsManager::printSms(sms);
+    }
 
-#if SMS_DELETE_AFTER_SEND
-                            // Mark this index for deletion
-                            partsToDelete.push_back(sms.index);
-
-                            // For multi-part SMS, also mark all other parts for deletion
-                            // (they were already processed by concatenator)
-                            if (sms.partInfo.isMultiPart) {
-                                // Note: We only have the last part's index here
-                                // Other parts are already in the list from previous iterations
-                            }
-#endif
-                        } else {
-                            DEBUG_PRINTLN("✗ Failed to send SMS to server");
-                            DEBUG_PRINT("Error: ");
-                            DEBUG_PRINTLN(httpSender->getLastError());
-                            DEBUG_PRINTLN("SMS will be retried on next check");
-                        }
-                    } else {
-                        // Part of multi-part SMS, waiting for more parts
-                        DEBUG_PRINTLN("⏳ Part buffered, waiting for remaining parts");
-#if SMS_DELETE_AFTER_SEND
-                        // Delete this part from SIM immediately to free up space
-                        // (it's already stored in RAM buffer)
-                        partsToDelete.push_back(sms.index);
+    // Only a single-part message keeps its lane through reassembly; a part
+    // may end up in a bulk entry (an amendment, or a code split across
+    // parts), so it needs bulk room
+    SmsLane lane = SmsClassifier::classify(sms);
+    bool needsBulkRoom = lane == SmsLane::BULK || sms.partInfo.isMultiPart;
+    if (lane == SmsLane::PRIORITY) {
+        DEBUG_PRINTLN("⚡ Priority message");
+    }
+    if (needsBulkRoom && smsOutbox.room(SmsLane::BULK) <= 0) {
+        DEBUG_PRINTLN("⏸ Bulk lane full, parked");
+        parkedQueue.send(&raw, 0);  // The caller checked for space
+        return;
+    }
+
+    uint64_t fingerprint = DuplicateFilter::fingerprint(sms);
+#if SMS_DEDUP_ENABLED
+    // Network re-delivery, or a SIM copy whose delete failed
+    if (duplicateFilter.contains(fingerprint) || smsOutbox.contains(fingerprint)) {
+        duplicateFilter.countDuplicate();
+        DEBUG_PRINTLN("↺ Duplicate of an SMS already handled, skipping");
+        postDone(sms.index, true);
+        return;
+    }
 #endif
-                    }
-                } else {
-                    DEBUG_PRINTLN("✗ Failed to read SMS");
-                }
 
-                DEBUG_PRINTLN();
+    // Reassembly pool full: the earliest message is resolved early and
+    // this part waits for its slot
+    if (!smsConcatenator.hasRoomFor(sms)) {
+        smsConcatenator.expediteOldest();
+        DEBUG_PRINTLN("⏸ Reassembly pool full, parked");
+        parkedQueue.send(&raw, 0);  // The caller checked for space
+        return;
+    }
+
+    // Add to concatenator (handles both single and multi-part SMS)
+    SmsMessage* completeSms = smsConcatenator.addPart(sms);
+    if (completeSms != nullptr) {
+        // Complete message (single-part or all parts received): its SIM
+        // copy stays until the server has it. Its lane follows the whole
+        // text; amendments trail their partial on the bulk lane
+        SmsLane messageLane = completeSms->delivery == SmsDelivery::AMENDMENT
+            ? SmsLane::BULK : SmsClassifier::classify(*completeSms);
+        if (!queueForUplink(*completeSms, sms.index, fingerprint, messageLane, raw.readAt, false)) {
+            // The caller holds a free entry, so this shouldn't happen: leave the SMS
+            // on the SIM and the journal for a later pass
+            postDone(sms.index, false);
+        }
+        return;
+    }
+
+    // Part of multi-part SMS, waiting for more parts
+    DEBUG_PRINTLN("⏳ Part buffered, waiting for remaining parts");
+    PendingPart part = { (int16_t)sms.index, fingerprint };
+    pendingParts.push_back(part);
+}
+
+// Write the journal batch with one flush: buffered parts may then leave
+// the SIM, and RELEASE records stop a reset from restoring delivered messages
+void flushJournal() {
+    bool journaled = smsConcatenator.flushJournal();
+    if (pendingParts.empty()) {
+        return;
+    }
+    if (!journaled) {
+        DEBUG_PRINTLN("✗ Journal write failed, buffered parts stay on SIM");
+    }
+    for (const PendingPart& part : pendingParts) {
+#if SMS_DEDUP_ENABLED
+        // Fingerprints count only for SMS that are delivered or safely journaled
+        if (journaled) {
+            duplicateFilter.insert(part.fingerprint);
+        }
+#endif
+        postDone(part.index, journaled);
+    }
+    pendingParts.clear();
+}
+
+// An entry back from the uplink
+void finishDelivery(SmsOutboxEntry* entry) {
+    if (entry->expired) {
+        smsConcatenator.completeExpired(entry->delivered);
+        partialOutstanding = false;
+    } else if (entry->delivered) {
+        smsConcatenator.markDelivered(entry->message);
+#if SMS_DEDUP_ENABLED
+        duplicateFilter.insert(entry->fingerprint);
+#endif
+        uint32_t latency = millis() - entry->readAt;
+        portENTER_CRITICAL(&statsMux);
+        pipelineStats.lanes[(int)entry->lane].record(latency);
+        portEXIT_CRITICAL(&statsMux);
+    }
+    if (entry->simIndex >= 0) {
+        postDone(entry->simIndex, entry->delivered);
+    }
+    smsOutbox.release(entry);  // Lanes overtake each other: any order
+}
+
+// Resolve the partial multi-part SMS whose deadline passed first
+// (its parts are already off the SIM, so forward what arrived)
+void expirePartial() {
+    unsigned long partDeadline;
+    if (partialOutstanding || smsOutbox.room(SmsLane::BULK) <= 0 || !smsConcatenator.nextDeadline(partDeadline) ||
+        (long)(millis() - partDeadline) < 0) {
+        return;
+    }
+
+    SmsMessage* partialSms = smsConcatenator.nextExpired();
+    if (partialSms == nullptr) {
+        return;
+    }
+    if (partialSms->delivery == SmsDelivery::COMPLETE && smsOutbox.containsReassembled(*partialSms)) {
+        // Complete and already queued: it is delivered from there
+        smsConcatenator.completeExpired(false);
+        return;
+    }
+
+    DEBUG_PRINTF("→ Sending partial message to server (%d/%d parts)\n",
+        partialSms->partsReceived, partialSms->partInfo.totalParts);
+    if (!queueForUplink(*partialSms, -1, 0, SmsLane::BULK, 0, true)) {
+        smsConcatenator.completeExpired(false);  // Retried after SMS_CONCAT_RETRY_INTERVAL
+        return;
+    }
+    partialOutstanding = true;
+}
+
+// Copy the decode task's own counters where the status report can read them
+void publishDecodeStats() {
+#if SMS_DEDUP_ENABLED
+    uint32_t duplicates = duplicateFilter.getDuplicateCount();
+#else
+    uint32_t duplicates = 0;
+#endif
+    uint32_t collisions = smsConcatenator.getCollisionCount();
+    portENTER_CRITICAL(&statsMux);
+    pipelineStats.duplicates = duplicates;
+    pipelineStats.collisions = collisions;
+    portEXIT_CRITICAL(&statsMux);
+}
+
+void decodeTask(void* param) {
+    while (true) {
+        // Sent messages first: they free outbox room
+        SmsOutboxEntry* entry;
+        bool finished = false;
+        while (resultQueue.receive(&entry, 0)) {
+            finishDelivery(entry);
+            finished = true;
+        }
+        if (finished) {
+            flushJournal();  // Their RELEASE records
+        }
+
+        // Parked PDUs next, in order, as bulk entries or reassembly slots
+        // free up. Each is tried once per pass: it may park again
+        SmsRawPdu raw;
+        int parked = parkedQueue.depth();
+        while (parked-- > 0 && smsOutbox.room(SmsLane::BULK) > 0 && parkedQueue.receive(&raw, 0)) {
+            decodePdu(raw, true);
+        }
+
+        // One new PDU per pass, while an entry is free and it could be parked
+        bool canTake = smsOutbox.room(SmsLane::PRIORITY) > 0 && parkedQueue.space() > 0;
+        if (canTake && rawQueue.receive(&raw, 0)) {
+            decodePdu(raw);
+        }
+
+        // End of a burst: one journal flush, one NVS write
+        if (rawQueue.depth() == 0) {
+            flushJournal();
+#if SMS_DEDUP_ENABLED
+            if (resultQueue.depth() == 0) {
+                duplicateFilter.commit();
             }
+#endif
+        }
 
-#if SMS_DELETE_AFTER_SEND
-            // Delete all processed parts
-            for (int idx : partsToDelete) {
-                if (smsManager->deleteSms(idx)) {
-                    DEBUG_PRINTF("✓ SMS %d deleted from SIM\n", idx);
-                } else {
-                    DEBUG_PRINTF("✗ Failed to delete SMS %d from SIM\n", idx);
+        expirePartial();
+        publishDecodeStats();
+
+        // Block until a PDU or a result arrives, or the earliest reassembly
+        // deadline if a partial could go out now
+        canTake = smsOutbox.room(SmsLane::PRIORITY) > 0 && parkedQueue.space() > 0;
+        if (canTake && rawQueue.depth() > 0) {
+            continue;
+        }
+        TickType_t wait = portMAX_DELAY;
+        unsigned long partDeadline;
+        bool canExpire = !partialOutstanding && smsOutbox.room(SmsLane::BULK) > 0;
+        if (canExpire && smsConcatenator.nextDeadline(partDeadline)) {
+            wait = EventBus::ticksUntil(partDeadline);
+        }
+        EventBus::wait(EventBit::RAW_READY | EventBit::RESULT_READY, wait);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Uplink task: HTTPS POST next to the WiFi stack
+// ---------------------------------------------------------------------------
+
+// One POST attempt for an entry (waits for WiFi first)
+bool postEntry(SmsOutboxEntry* entry) {
+    // No point posting without WiFi: wait for the connection event
+    if (!EventBus::isSet(EventBit::WIFI_UP)) {
+        DEBUG_PRINTLN("Uplink waiting for WiFi");
+        EventBus::waitLevel(EventBit::WIFI_UP, portMAX_DELAY);
+    }
+
+    DEBUG_PRINTF("→ Sending %s message to server\n", entry->lane == SmsLane::PRIORITY ? "priority" : "bulk");
+    if (httpSender->sendSmsToServer(entry->message)) {
+        DEBUG_PRINTLN("✓ SMS successfully sent to server");
+        return true;
+    }
+    DEBUG_PRINTLN("✗ Failed to send SMS to server");
+    DEBUG_PRINT("Error: ");
+    DEBUG_PRINTLN(httpSender->getLastError());
+    return false;
+}
+
+void uplinkTask(void* param) {
+    // Per lane: a SIM message the server refused, resent in place at retryAt.
+    // Its lane waits behind it (the bulk backlog then throttles paging);
+    // the other lane keeps going. After SMS_SEND_ATTEMPTS, or a permanent
+    // refusal, it goes back unconsumed and is re-read from the SIM later,
+    // so one bad message can't stall its lane
+    StageQueue* lanes[] = { &fastQueue, &uplinkQueue };
+    SmsOutboxEntry* held[] = { nullptr, nullptr };
+    unsigned long retryAt[] = { 0, 0 };
+
+    while (true) {
+        // Priority lane first, on every pass
+        SmsOutboxEntry* entry = nullptr;
+        int lane;
+        for (lane = 0; lane < 2; lane++) {
+            if (held[lane] == nullptr) {
+                if (lanes[lane]->receive(&entry, 0)) {
+                    break;
                 }
+            } else if ((long)(millis() - retryAt[lane]) >= 0) {
+                entry = held[lane];
+                held[lane] = nullptr;
+                break;
             }
-#endif
+        }
+
+        if (entry == nullptr) {
+            // Sleep until a lane gets an entry or a retry falls due
+            TickType_t wait = portMAX_DELAY;
+            for (int i = 0; i < 2; i++) {
+                if (held[i] != nullptr) {
+                    wait = min(wait, EventBus::ticksUntil(retryAt[i]));
+                }
+            }
+            EventBus::wait(EventBit::UPLINK_READY, wait);
+            continue;
+        }
+
+        entry->delivered = postEntry(entry);
+        entry->attempts++;
 
-            DEBUG_PRINTLN("--- SMS processing completed ---\n");
+        // Partials report back at once
+        bool onSim = !entry->expired && entry->simIndex >= 0;
+        bool retryInPlace = onSim && entry->attempts < SMS_SEND_ATTEMPTS && !httpSender->isPermanentFailure();
+        if (!entry->delivered && retryInPlace) {
+            unsigned long backoff = (unsigned long)SMS_RETRY_INTERVAL * entry->attempts;
+            DEBUG_PRINTF("Retrying in %lu s (%u queued behind)\n",
+                backoff / 1000, (unsigned)lanes[lane]->depth());
+            held[lane] = entry;
+            retryAt[lane] = millis() + backoff;
+            continue;
+        }
+        if (!entry->delivered && onSim) {
+            DEBUG_PRINTF("Giving up after %d attempts, SMS %d stays on the SIM\n", entry->attempts, entry->simIndex);
         }
+
+        resultQueue.send(&entry, portMAX_DELAY);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+bool startPipeline() {
+    // Queue lengths bound every stage: the modem task pages only into free
+    // decode slots, the decode task only lends free outbox entries. Taking
+    // from the raw or bulk uplink queue wakes a throttled modem task
+    if (!rawQueue.create("raw", SMS_INBOX_PAGE_SIZE, sizeof(SmsRawPdu),
+                         EventBit::RAW_READY, EventBit::PIPELINE_FREE) ||
+        !uplinkQueue.create("uplink", SMS_OUTBOX_CAPACITY, sizeof(SmsOutboxEntry*),
+                            EventBit::UPLINK_READY, EventBit::PIPELINE_FREE) ||
+        !fastQueue.create("fast", SMS_OUTBOX_CAPACITY, sizeof(SmsOutboxEntry*),
+                          EventBit::UPLINK_READY, 0) ||
+        !parkedQueue.create("parked", SMS_INBOX_PAGE_SIZE, sizeof(SmsRawPdu), 0, 0) ||
+        !resultQueue.create("result", SMS_OUTBOX_CAPACITY, sizeof(SmsOutboxEntry*),
+                            EventBit::RESULT_READY, 0) ||
+        !doneQueue.create("done", DONE_QUEUE_LENGTH, sizeof(SmsSlotDone),
+                          EventBit::SLOT_DONE, 0)) {
+        DEBUG_PRINTLN("ERROR: Failed to create pipeline queues");
+        return false;
+    }
+
+    // Wake sources: modem bytes outside AT commands, WiFi state changes
+    // (the RING interrupt signals from SmsManager)
+    SerialAT.onReceive([]() { EventBus::signal(EventBit::MODEM_UART); });
+    wifiManager.watchEvents();
+    enableLightSleep();
+
+    // Core 0 runs the WiFi/TLS stack, core 1 the modem UART
+    return xTaskCreatePinnedToCore(modemTask, "sms_modem", MODEM_TASK_STACK, nullptr,
+                                   MODEM_TASK_PRIORITY, nullptr, MODEM_TASK_CORE) == pdPASS &&
+           xTaskCreatePinnedToCore(decodeTask, "sms_decode", DECODE_TASK_STACK, nullptr,
+                                   DECODE_TASK_PRIORITY, nullptr, DECODE_TASK_CORE) == pdPASS &&
+           xTaskCreatePinnedToCore(uplinkTask, "sms_uplink", UPLINK_TASK_STACK, nullptr,
+                                   UPLINK_TASK_PRIORITY, nullptr, UPLINK_TASK_CORE) == pdPASS;
+}
+
+void reportQueue(const StageQueue& queue) {
+    DEBUG_PRINTF("  %-6s %u/%u (peak %u)\n", queue.name, (unsigned)queue.depth(),
+        (unsigned)queue.length, (unsigned)queue.peak);
+}
+
+// Let the chip light-sleep whenever every task is blocked
+void enableLightSleep() {
+#if LIGHT_SLEEP_ACTIVE
+    if (esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "modem", &modemAwake) != ESP_OK) {
+        DEBUG_PRINTLN("WARNING: Light sleep unavailable (PM lock)");
+        return;
+    }
+
+    // Wake on a RING pulse or modem UART activity. The bytes that wake the
+    // UART are lost, but the RING pulse alone schedules an inbox scan
+#ifdef MODEM_RING_PIN
+    gpio_wakeup_enable((gpio_num_t)MODEM_RING_PIN, GPIO_INTR_LOW_LEVEL);
+    esp_sleep_enable_gpio_wakeup();
+#endif
+    uart_set_wakeup_threshold(UART_NUM_1, 3);
+    esp_sleep_enable_uart_wakeup(UART_NUM_1);
+
+    esp_pm_config_esp32_t pm = { POWER_CPU_MAX_MHZ, POWER_CPU_MIN_MHZ, true };
+    if (esp_pm_configure(&pm) != ESP_OK) {
+        DEBUG_PRINTLN("WARNING: Light sleep unavailable (PM config)");
+        return;
+    }
+    DEBUG_PRINTLN("Light sleep enabled while idle");
+#endif
+}
+
+// The SMS work runs in the pipeline tasks; the loop supervises WiFi and
+// reports stage health. It sleeps until WiFi drops or the report is due
+void loop() {
+    static unsigned long nextReport = 0;
+
+    if (!wifiManager.isConnected()) {
+        DEBUG_PRINTLN("WARNING: WiFi connection lost!");
+        wifiManager.reconnect();
+    }
+
+    if ((long)(millis() - nextReport) >= 0) {
+        nextReport = millis() + NETWORK_CHECK_INTERVAL;
+        reportPipeline();
     }
 
-    // Small delay to prevent tight loop
-    delay(100);
+    // Still down: try again once the reconnect backoff has passed
+    TickType_t wait = wifiManager.isConnected() ? EventBus::ticksUntil(nextReport)
+                                                : pdMS_TO_TICKS(WiFiManager::RECONNECT_INTERVAL);
+    EventBus::wait(EventBit::WIFI_LOST, wait);
+}
+
+void reportPipeline() {
+    DEBUG_PRINTLN("Pipeline queues:");
+    reportQueue(rawQueue);
+    reportQueue(uplinkQueue);
+    reportQueue(fastQueue);
+    reportQueue(parkedQueue);
+    reportQueue(resultQueue);
+    reportQueue(doneQueue);
+
+    // Snapshot first: no printing inside a critical section
+    PipelineStats stats;
+    portENTER_CRITICAL(&statsMux);
+    stats = pipelineStats;
+    portEXIT_CRITICAL(&statsMux);
+
+    for (const LaneStats& lane : stats.lanes) {
+        if (lane.delivered > 0) {
+            DEBUG_PRINTF("%s lane: %u delivered, latency avg %u ms, max %u ms\n", lane.name,
+                (unsigned)lane.delivered, (unsigned)(lane.totalMs / lane.delivered), (unsigned)lane.maxMs);
+        }
+    }
+    if (stats.pagingThrottled > 0) {
+        DEBUG_PRINTF("Inbox paging held back by the pipeline: %u passes\n", (unsigned)stats.pagingThrottled);
+    }
+    if (stats.duplicates > 0) {
+        DEBUG_PRINTF("Duplicate SMS dropped so far: %u\n", (unsigned)stats.duplicates);
+    }
+    if (stats.collisions > 0) {
+        DEBUG_PRINTF("Multi-part reference collisions so far: %u\n", (unsigned)stats.collisions);
+    }
 }
@@ -0,0 +1,151 @@
+#include "sms/duplicate_filter.h"
+#include <Preferences.h>
+
+static const char* NVS_NAMESPACE = "sms_dedup";
+
+DuplicateFilter::DuplicateFilter() : head(0), count(0), dirty(false), duplicateCount(0) {
+    memset(index, 0xFF, sizeof(index));
+}
+
+bool DuplicateFilter::init() {
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, true)) {
+        DEBUG_PRINTLN("Duplicate filter: no stored fingerprints");
+        return true;  // First boot: namespace doesn't exist yet
+    }
+
+    uint32_t meta = prefs.getUInt("meta", 0);
+    size_t stored = prefs.getBytes("ring", ring, sizeof(ring));
+    prefs.end();
+
+    head = meta >> 16;
+    count = meta & 0xFFFF;
+    if (stored != sizeof(ring) || head >= SMS_DEDUP_CAPACITY || count > SMS_DEDUP_CAPACITY) {
+        // Missing, or stored with a different capacity
+        head = 0;
+        count = 0;
+    }
+
+    // Rebuild the index from the ring
+    memset(index, 0xFF, sizeof(index));
+    for (int i = 0; i < count; i++) {
+        int pos = (head - count + i + SMS_DEDUP_CAPACITY) % SMS_DEDUP_CAPACITY;
+        indexInsert(pos);
+    }
+
+    DEBUG_PRINTF("Duplicate filter: %d fingerprints loaded\n", count);
+    return true;
+}
+
+uint64_t DuplicateFilter::fingerprint(const SmsMessage& sms) {
+    const SmsPartInfo& info = sms.partInfo;
+    uint8_t part[5] = {
+        (uint8_t)(info.refNumber >> 8), (uint8_t)info.refNumber,
+        (uint8_t)(info.isMultiPart ? (info.ref16Bit ? 16 : 8) : 0),
+        info.totalParts, info.partNumber
+    };
+
+    // Fields are NUL-separated so "ab"+"c" and "a"+"bc" differ
+    static const uint8_t SEPARATOR = 0;
+    uint64_t hash = DedupConst::FNV_OFFSET;
+    hash = mix(hash, (const uint8_t*)sms.sender.c_str(), sms.sender.length());
+    hash = mix(hash, &SEPARATOR, 1);
+    hash = mix(hash, (const uint8_t*)sms.timestamp.c_str(), sms.timestamp.length());
+    hash = mix(hash, &SEPARATOR, 1);
+    hash = mix(hash, part, sizeof(part));
+    hash = mix(hash, (const uint8_t*)sms.text.c_str(), sms.text.length());
+    return hash;
+}
+
+uint64_t DuplicateFilter::mix(uint64_t hash, const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ data[i]) * DedupConst::FNV_PRIME;
+    }
+    return hash;
+}
+
+void DuplicateFilter::insert(uint64_t fp) {
+    if (contains(fp)) {
+        return;
+    }
+
+    // Full: the oldest fingerprint (at head) is overwritten
+    if (count == SMS_DEDUP_CAPACITY) {
+        indexRemove(ring[head]);
+    } else {
+        count++;
+    }
+
+    ring[head] = fp;
+    indexInsert(head);
+    head = (head + 1) % SMS_DEDUP_CAPACITY;
+    dirty = true;
+}
+
+bool DuplicateFilter::commit() {
+    if (!dirty) {
+        return true;
+    }
+
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, false)) {
+        DEBUG_PRINTLN("ERROR: Failed to open NVS for duplicate filter");
+        return false;
+    }
+    bool ok = prefs.putBytes("ring", ring, sizeof(ring)) == sizeof(ring) &&
+              prefs.putUInt("meta", ((uint32_t)head << 16) | count) == sizeof(uint32_t);
+    prefs.end();
+
+    if (!ok) {
+        DEBUG_PRINTLN("ERROR: Failed to store duplicate filter");
+        return false;
+    }
+    dirty = false;
+    return true;
+}
+
+int DuplicateFilter::find(uint64_t fp) const {
+    int bucket = homeBucket(fp);
+    while (index[bucket] != DedupConst::EMPTY) {
+        if (ring[index[bucket]] == fp) {
+            return bucket;
+        }
+        bucket = (bucket + 1) & (DedupConst::TABLE_SIZE - 1);
+    }
+    return -1;
+}
+
+void DuplicateFilter::indexInsert(uint16_t ringPos) {
+    int bucket = homeBucket(ring[ringPos]);
+    while (index[bucket] != DedupConst::EMPTY) {
+        bucket = (bucket + 1) & (DedupConst::TABLE_SIZE - 1);
+    }
+    index[bucket] = ringPos;
+}
+
+void DuplicateFilter::indexRemove(uint64_t fp) {
+    int hole = find(fp);
+    if (hole < 0) {
+        return;
+    }
+
+    // Backward-shift deletion: pull later entries of the probe run into the
+    // hole so lookups never stop early at it
+    const int mask = DedupConst::TABLE_SIZE - 1;
+    int bucket = hole;
+    while (true) {
+        bucket = (bucket + 1) & mask;
+        if (index[bucket] == DedupConst::EMPTY) {
+            break;
+        }
+        int home = homeBucket(ring[index[bucket]]);
+        // Entry can move only if its home isn't in (hole, bucket]
+        bool homeBetween = hole <= bucket ? (home > hole && home <= bucket)
+                                          : (home > hole || home <= bucket);
+        if (!homeBetween) {
+            index[hole] = index[bucket];
+            hole = bucket;
+        }
+    }
+    index[hole] = DedupConst::EMPTY;
+}
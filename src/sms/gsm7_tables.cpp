@@ -0,0 +1,585 @@
+#include "sms/gsm7_tables.h"
+
+namespace Gsm7Tables {
+
+// GSM 7-bit default alphabet table (basic)
+constexpr Gsm7Utf8 BASIC[128] = {
+    {1, "@"}, {2, "£"}, {1, "$"}, {2, "¥"}, {2, "è"}, {2, "é"}, {2, "ù"}, {2, "ì"},  // 0x00
+    {2, "ò"}, {2, "Ç"}, {1, "\n"}, {2, "Ø"}, {2, "ø"}, {1, "\r"}, {2, "Å"}, {2, "å"},  // 0x08
+    {2, "Δ"}, {1, "_"}, {2, "Φ"}, {2, "Γ"}, {2, "Λ"}, {2, "Ω"}, {2, "Π"}, {2, "Ψ"},  // 0x10
+    {2, "Σ"}, {2, "Θ"}, {2, "Ξ"}, {0, ""}, {2, "Æ"}, {2, "æ"}, {2, "ß"}, {2, "É"},  // 0x18
+    {1, " "}, {1, "!"}, {1, "\""}, {1, "#"}, {2, "¤"}, {1, "%"}, {1, "&"}, {1, "'"},  // 0x20
+    {1, "("}, {1, ")"}, {1, "*"}, {1, "+"}, {1, ","}, {1, "-"}, {1, "."}, {1, "/"},  // 0x28
+    {1, "0"}, {1, "1"}, {1, "2"}, {1, "3"}, {1, "4"}, {1, "5"}, {1, "6"}, {1, "7"},  // 0x30
+    {1, "8"}, {1, "9"}, {1, ":"}, {1, ";"}, {1, "<"}, {1, "="}, {1, ">"}, {1, "?"},  // 0x38
+    {2, "¡"}, {1, "A"}, {1, "B"}, {1, "C"}, {1, "D"}, {1, "E"}, {1, "F"}, {1, "G"},  // 0x40
+    {1, "H"}, {1, "I"}, {1, "J"}, {1, "K"}, {1, "L"}, {1, "M"}, {1, "N"}, {1, "O"},  // 0x48
+    {1, "P"}, {1, "Q"}, {1, "R"}, {1, "S"}, {1, "T"}, {1, "U"}, {1, "V"}, {1, "W"},  // 0x50
+    {1, "X"}, {1, "Y"}, {1, "Z"}, {2, "Ä"}, {2, "Ö"}, {2, "Ñ"}, {2, "Ü"}, {2, "§"},  // 0x58
+    {2, "¿"}, {1, "a"}, {1, "b"}, {1, "c"}, {1, "d"}, {1, "e"}, {1, "f"}, {1, "g"},  // 0x60
+    {1, "h"}, {1, "i"}, {1, "j"}, {1, "k"}, {1, "l"}, {1, "m"}, {1, "n"}, {1, "o"},  // 0x68
+    {1, "p"}, {1, "q"}, {1, "r"}, {1, "s"}, {1, "t"}, {1, "u"}, {1, "v"}, {1, "w"},  // 0x70
+    {1, "x"}, {1, "y"}, {1, "z"}, {2, "ä"}, {2, "ö"}, {2, "ñ"}, {2, "ü"}, {2, "à"}   // 0x78
+};
+
+// GSM 7-bit default extension table (escape sequences, accessed via ESC)
+// 0x0A form feed, 0x14 ^, 0x28 {, 0x29 }, 0x2F \, 0x3C [, 0x3D ~, 0x3E ], 0x40 |, 0x65 €
+constexpr Gsm7Utf8 EXTENDED[128] = {
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x00
+    {0, ""}, {0, ""}, {1, "\f"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x08
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "^"}, {0, ""}, {0, ""}, {0, ""},  // 0x10
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x18
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x20
+    {1, "{"}, {1, "}"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "\\"},  // 0x28
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x30
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "["}, {1, "~"}, {1, "]"}, {0, ""},  // 0x38
+    {1, "|"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x40
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x48
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x50
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x58
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {3, "€"}, {0, ""}, {0, ""},  // 0x60
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x68
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x70
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}   // 0x78
+};
+
+// National language tables
+
+// Turkish locking shift table (A.3.1)
+constexpr Gsm7Utf8 TURKISH_LOCKING[128] = {
+    {1, "@"}, {2, "£"}, {1, "$"}, {2, "¥"}, {3, "€"}, {2, "é"}, {2, "ù"}, {2, "ı"},  // 0x00
+    {2, "ò"}, {2, "Ç"}, {1, "\n"}, {2, "Ğ"}, {2, "ğ"}, {1, "\r"}, {2, "Å"}, {2, "å"},  // 0x08
+    {2, "Δ"}, {1, "_"}, {2, "Φ"}, {2, "Γ"}, {2, "Λ"}, {2, "Ω"}, {2, "Π"}, {2, "Ψ"},  // 0x10
+    {2, "Σ"}, {2, "Θ"}, {2, "Ξ"}, {0, ""}, {2, "Ş"}, {2, "ş"}, {2, "ß"}, {2, "É"},  // 0x18
+    {1, " "}, {1, "!"}, {1, "\""}, {1, "#"}, {2, "¤"}, {1, "%"}, {1, "&"}, {1, "'"},  // 0x20
+    {1, "("}, {1, ")"}, {1, "*"}, {1, "+"}, {1, ","}, {1, "-"}, {1, "."}, {1, "/"},  // 0x28
+    {1, "0"}, {1, "1"}, {1, "2"}, {1, "3"}, {1, "4"}, {1, "5"}, {1, "6"}, {1, "7"},  // 0x30
+    {1, "8"}, {1, "9"}, {1, ":"}, {1, ";"}, {1, "<"}, {1, "="}, {1, ">"}, {1, "?"},  // 0x38
+    {2, "İ"}, {1, "A"}, {1, "B"}, {1, "C"}, {1, "D"}, {1, "E"}, {1, "F"}, {1, "G"},  // 0x40
+    {1, "H"}, {1, "I"}, {1, "J"}, {1, "K"}, {1, "L"}, {1, "M"}, {1, "N"}, {1, "O"},  // 0x48
+    {1, "P"}, {1, "Q"}, {1, "R"}, {1, "S"}, {1, "T"}, {1, "U"}, {1, "V"}, {1, "W"},  // 0x50
+    {1, "X"}, {1, "Y"}, {1, "Z"}, {2, "Ä"}, {2, "Ö"}, {2, "Ñ"}, {2, "Ü"}, {2, "§"},  // 0x58
+    {2, "ç"}, {1, "a"}, {1, "b"}, {1, "c"}, {1, "d"}, {1, "e"}, {1, "f"}, {1, "g"},  // 0x60
+    {1, "h"}, {1, "i"}, {1, "j"}, {1, "k"}, {1, "l"}, {1, "m"}, {1, "n"}, {1, "o"},  // 0x68
+    {1, "p"}, {1, "q"}, {1, "r"}, {1, "s"}, {1, "t"}, {1, "u"}, {1, "v"}, {1, "w"},  // 0x70
+    {1, "x"}, {1, "y"}, {1, "z"}, {2, "ä"}, {2, "ö"}, {2, "ñ"}, {2, "ü"}, {2, "à"}   // 0x78
+};
+
+// Portuguese locking shift table (A.3.3)
+constexpr Gsm7Utf8 PORTUGUESE_LOCKING[128] = {
+    {1, "@"}, {2, "£"}, {1, "$"}, {2, "¥"}, {2, "ê"}, {2, "é"}, {2, "ú"}, {2, "í"},  // 0x00
+    {2, "ó"}, {2, "ç"}, {1, "\n"}, {2, "Ô"}, {2, "ô"}, {1, "\r"}, {2, "Á"}, {2, "á"},  // 0x08
+    {2, "Δ"}, {1, "_"}, {2, "ª"}, {2, "Ç"}, {2, "À"}, {3, "∞"}, {1, "^"}, {1, "\\"},  // 0x10
+    {3, "€"}, {2, "Ó"}, {1, "|"}, {0, ""}, {2, "Â"}, {2, "â"}, {2, "Ê"}, {2, "É"},  // 0x18
+    {1, " "}, {1, "!"}, {1, "\""}, {1, "#"}, {2, "º"}, {1, "%"}, {1, "&"}, {1, "'"},  // 0x20
+    {1, "("}, {1, ")"}, {1, "*"}, {1, "+"}, {1, ","}, {1, "-"}, {1, "."}, {1, "/"},  // 0x28
+    {1, "0"}, {1, "1"}, {1, "2"}, {1, "3"}, {1, "4"}, {1, "5"}, {1, "6"}, {1, "7"},  // 0x30
+    {1, "8"}, {1, "9"}, {1, ":"}, {1, ";"}, {1, "<"}, {1, "="}, {1, ">"}, {1, "?"},  // 0x38
+    {2, "Í"}, {1, "A"}, {1, "B"}, {1, "C"}, {1, "D"}, {1, "E"}, {1, "F"}, {1, "G"},  // 0x40
+    {1, "H"}, {1, "I"}, {1, "J"}, {1, "K"}, {1, "L"}, {1, "M"}, {1, "N"}, {1, "O"},  // 0x48
+    {1, "P"}, {1, "Q"}, {1, "R"}, {1, "S"}, {1, "T"}, {1, "U"}, {1, "V"}, {1, "W"},  // 0x50
+    {1, "X"}, {1, "Y"}, {1, "Z"}, {2, "Ã"}, {2, "Õ"}, {2, "Ú"}, {2, "Ü"}, {2, "§"},  // 0x58
+    {1, "~"}, {1, "a"}, {1, "b"}, {1, "c"}, {1, "d"}, {1, "e"}, {1, "f"}, {1, "g"},  // 0x60
+    {1, "h"}, {1, "i"}, {1, "j"}, {1, "k"}, {1, "l"}, {1, "m"}, {1, "n"}, {1, "o"},  // 0x68
+    {1, "p"}, {1, "q"}, {1, "r"}, {1, "s"}, {1, "t"}, {1, "u"}, {1, "v"}, {1, "w"},  // 0x70
+    {1, "x"}, {1, "y"}, {1, "z"}, {2, "ã"}, {2, "õ"}, {1, "`"}, {2, "ü"}, {2, "à"}   // 0x78
+};
+
+// Turkish single shift table (A.2.1)
+constexpr Gsm7Utf8 TURKISH_SINGLE[128] = {
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x00
+    {0, ""}, {0, ""}, {1, "\f"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x08
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "^"}, {0, ""}, {0, ""}, {0, ""},  // 0x10
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x18
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x20
+    {1, "{"}, {1, "}"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "\\"},  // 0x28
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x30
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "["}, {1, "~"}, {1, "]"}, {0, ""},  // 0x38
+    {1, "|"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {2, "Ğ"},  // 0x40
+    {0, ""}, {2, "İ"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x48
+    {0, ""}, {0, ""}, {0, ""}, {2, "Ş"}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x50
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x58
+    {0, ""}, {0, ""}, {0, ""}, {2, "ç"}, {0, ""}, {3, "€"}, {0, ""}, {2, "ğ"},  // 0x60
+    {0, ""}, {2, "ı"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x68
+    {0, ""}, {0, ""}, {0, ""}, {2, "ş"}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x70
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}   // 0x78
+};
+
+// Spanish single shift table (A.2.2)
+constexpr Gsm7Utf8 SPANISH_SINGLE[128] = {
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x00
+    {0, ""}, {2, "ç"}, {1, "\f"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x08
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "^"}, {0, ""}, {0, ""}, {0, ""},  // 0x10
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x18
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x20
+    {1, "{"}, {1, "}"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "\\"},  // 0x28
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x30
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "["}, {1, "~"}, {1, "]"}, {0, ""},  // 0x38
+    {1, "|"}, {2, "Á"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x40
+    {0, ""}, {2, "Í"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {2, "Ó"},  // 0x48
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {2, "Ú"}, {0, ""}, {0, ""},  // 0x50
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x58
+    {0, ""}, {2, "á"}, {0, ""}, {0, ""}, {0, ""}, {3, "€"}, {0, ""}, {0, ""},  // 0x60
+    {0, ""}, {2, "í"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {2, "ó"},  // 0x68
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {2, "ú"}, {0, ""}, {0, ""},  // 0x70
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}   // 0x78
+};
+
+// Portuguese single shift table (A.2.3)
+constexpr Gsm7Utf8 PORTUGUESE_SINGLE[128] = {
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {2, "ê"}, {0, ""}, {0, ""},  // 0x00
+    {0, ""}, {2, "ç"}, {1, "\f"}, {2, "Ô"}, {2, "ô"}, {0, ""}, {2, "Á"}, {2, "á"},  // 0x08
+    {0, ""}, {0, ""}, {2, "Φ"}, {2, "Γ"}, {1, "^"}, {2, "Ω"}, {2, "Π"}, {2, "Ψ"},  // 0x10
+    {2, "Σ"}, {2, "Θ"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {2, "Ê"},  // 0x18
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x20
+    {1, "{"}, {1, "}"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "\\"},  // 0x28
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x30
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "["}, {1, "~"}, {1, "]"}, {0, ""},  // 0x38
+    {1, "|"}, {2, "À"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x40
+    {0, ""}, {2, "Í"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {2, "Ó"},  // 0x48
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {2, "Ú"}, {0, ""}, {0, ""},  // 0x50
+    {0, ""}, {0, ""}, {0, ""}, {2, "Ã"}, {2, "Õ"}, {0, ""}, {0, ""}, {0, ""},  // 0x58
+    {0, ""}, {2, "Â"}, {0, ""}, {0, ""}, {0, ""}, {3, "€"}, {0, ""}, {0, ""},  // 0x60
+    {0, ""}, {2, "í"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {2, "ó"},  // 0x68
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {2, "ú"}, {0, ""}, {0, ""},  // 0x70
+    {0, ""}, {0, ""}, {0, ""}, {2, "ã"}, {2, "õ"}, {0, ""}, {0, ""}, {2, "â"}   // 0x78
+};
+
+// Bengali locking shift table (A.3.4)
+constexpr Gsm7Utf8 BENGALI_LOCKING[128] = {
+    {3, "ঁ"}, {3, "ং"}, {3, "ঃ"}, {3, "অ"}, {3, "আ"}, {3, "ই"}, {3, "ঈ"}, {3, "উ"},  // 0x00
+    {3, "ঊ"}, {3, "ঋ"}, {1, "\n"}, {3, "ঌ"}, {0, ""}, {1, "\r"}, {0, ""}, {3, "এ"},  // 0x08
+    {3, "ঐ"}, {0, ""}, {0, ""}, {3, "ও"}, {3, "ঔ"}, {3, "ক"}, {3, "খ"}, {3, "গ"},  // 0x10
+    {3, "ঘ"}, {3, "ঙ"}, {3, "চ"}, {0, ""}, {3, "ছ"}, {3, "জ"}, {3, "ঝ"}, {3, "ঞ"},  // 0x18
+    {1, " "}, {1, "!"}, {3, "ট"}, {3, "ঠ"}, {3, "ড"}, {3, "ঢ"}, {3, "ণ"}, {3, "ত"},  // 0x20
+    {1, ")"}, {1, "("}, {3, "থ"}, {3, "দ"}, {1, ","}, {3, "ধ"}, {1, "."}, {3, "ন"},  // 0x28
+    {1, "0"}, {1, "1"}, {1, "2"}, {1, "3"}, {1, "4"}, {1, "5"}, {1, "6"}, {1, "7"},  // 0x30
+    {1, "8"}, {1, "9"}, {1, ":"}, {1, ";"}, {0, ""}, {3, "প"}, {3, "ফ"}, {1, "?"},  // 0x38
+    {3, "ব"}, {3, "ভ"}, {3, "ম"}, {3, "য"}, {3, "র"}, {0, ""}, {3, "ল"}, {0, ""},  // 0x40
+    {0, ""}, {0, ""}, {3, "শ"}, {3, "ষ"}, {3, "স"}, {3, "হ"}, {3, "়"}, {3, "ঽ"},  // 0x48
+    {3, "া"}, {3, "ি"}, {3, "ী"}, {3, "ু"}, {3, "ূ"}, {3, "ৃ"}, {3, "ৄ"}, {0, ""},  // 0x50
+    {0, ""}, {3, "ে"}, {3, "ৈ"}, {0, ""}, {0, ""}, {3, "ো"}, {3, "ৌ"}, {3, "্"},  // 0x58
+    {3, "ৎ"}, {1, "a"}, {1, "b"}, {1, "c"}, {1, "d"}, {1, "e"}, {1, "f"}, {1, "g"},  // 0x60
+    {1, "h"}, {1, "i"}, {1, "j"}, {1, "k"}, {1, "l"}, {1, "m"}, {1, "n"}, {1, "o"},  // 0x68
+    {1, "p"}, {1, "q"}, {1, "r"}, {1, "s"}, {1, "t"}, {1, "u"}, {1, "v"}, {1, "w"},  // 0x70
+    {1, "x"}, {1, "y"}, {1, "z"}, {3, "ৗ"}, {3, "ড়"}, {3, "ঢ়"}, {3, "ৰ"}, {3, "ৱ"}   // 0x78
+};
+
+// Gujarati locking shift table (A.3.5)
+constexpr Gsm7Utf8 GUJARATI_LOCKING[128] = {
+    {3, "ઁ"}, {3, "ં"}, {3, "ઃ"}, {3, "અ"}, {3, "આ"}, {3, "ઇ"}, {3, "ઈ"}, {3, "ઉ"},  // 0x00
+    {3, "ઊ"}, {3, "ઋ"}, {1, "\n"}, {3, "ઌ"}, {3, "ઍ"}, {1, "\r"}, {0, ""}, {3, "એ"},  // 0x08
+    {3, "ઐ"}, {3, "ઑ"}, {0, ""}, {3, "ઓ"}, {3, "ઔ"}, {3, "ક"}, {3, "ખ"}, {3, "ગ"},  // 0x10
+    {3, "ઘ"}, {3, "ઙ"}, {3, "ચ"}, {0, ""}, {3, "છ"}, {3, "જ"}, {3, "ઝ"}, {3, "ઞ"},  // 0x18
+    {1, " "}, {1, "!"}, {3, "ટ"}, {3, "ઠ"}, {3, "ડ"}, {3, "ઢ"}, {3, "ણ"}, {3, "ત"},  // 0x20
+    {1, ")"}, {1, "("}, {3, "થ"}, {3, "દ"}, {1, ","}, {3, "ધ"}, {1, "."}, {3, "ન"},  // 0x28
+    {1, "0"}, {1, "1"}, {1, "2"}, {1, "3"}, {1, "4"}, {1, "5"}, {1, "6"}, {1, "7"},  // 0x30
+    {1, "8"}, {1, "9"}, {1, ":"}, {1, ";"}, {0, ""}, {3, "પ"}, {3, "ફ"}, {1, "?"},  // 0x38
+    {3, "બ"}, {3, "ભ"}, {3, "મ"}, {3, "ય"}, {3, "ર"}, {0, ""}, {3, "લ"}, {3, "ળ"},  // 0x40
+    {0, ""}, {3, "વ"}, {3, "શ"}, {3, "ષ"}, {3, "સ"}, {3, "હ"}, {3, "઼"}, {3, "ઽ"},  // 0x48
+    {3, "ા"}, {3, "િ"}, {3, "ી"}, {3, "ુ"}, {3, "ૂ"}, {3, "ૃ"}, {3, "ૄ"}, {3, "ૅ"},  // 0x50
+    {0, ""}, {3, "ે"}, {3, "ૈ"}, {3, "ૉ"}, {0, ""}, {3, "ો"}, {3, "ૌ"}, {3, "્"},  // 0x58
+    {3, "ૐ"}, {1, "a"}, {1, "b"}, {1, "c"}, {1, "d"}, {1, "e"}, {1, "f"}, {1, "g"},  // 0x60
+    {1, "h"}, {1, "i"}, {1, "j"}, {1, "k"}, {1, "l"}, {1, "m"}, {1, "n"}, {1, "o"},  // 0x68
+    {1, "p"}, {1, "q"}, {1, "r"}, {1, "s"}, {1, "t"}, {1, "u"}, {1, "v"}, {1, "w"},  // 0x70
+    {1, "x"}, {1, "y"}, {1, "z"}, {3, "ૠ"}, {3, "ૡ"}, {3, "ૢ"}, {3, "ૣ"}, {3, "૱"}   // 0x78
+};
+
+// Hindi locking shift table (A.3.6)
+constexpr Gsm7Utf8 HINDI_LOCKING[128] = {
+    {3, "ँ"}, {3, "ं"}, {3, "ः"}, {3, "अ"}, {3, "आ"}, {3, "इ"}, {3, "ई"}, {3, "उ"},  // 0x00
+    {3, "ऊ"}, {3, "ऋ"}, {1, "\n"}, {3, "ऌ"}, {3, "ऍ"}, {1, "\r"}, {3, "ऎ"}, {3, "ए"},  // 0x08
+    {3, "ऐ"}, {3, "ऑ"}, {3, "ऒ"}, {3, "ओ"}, {3, "औ"}, {3, "क"}, {3, "ख"}, {3, "ग"},  // 0x10
+    {3, "घ"}, {3, "ङ"}, {3, "च"}, {0, ""}, {3, "छ"}, {3, "ज"}, {3, "झ"}, {3, "ञ"},  // 0x18
+    {1, " "}, {1, "!"}, {3, "ट"}, {3, "ठ"}, {3, "ड"}, {3, "ढ"}, {3, "ण"}, {3, "त"},  // 0x20
+    {1, ")"}, {1, "("}, {3, "थ"}, {3, "द"}, {1, ","}, {3, "ध"}, {1, "."}, {3, "न"},  // 0x28
+    {1, "0"}, {1, "1"}, {1, "2"}, {1, "3"}, {1, "4"}, {1, "5"}, {1, "6"}, {1, "7"},  // 0x30
+    {1, "8"}, {1, "9"}, {1, ":"}, {1, ";"}, {3, "ऩ"}, {3, "प"}, {3, "फ"}, {1, "?"},  // 0x38
+    {3, "ब"}, {3, "भ"}, {3, "म"}, {3, "य"}, {3, "र"}, {3, "ऱ"}, {3, "ल"}, {3, "ळ"},  // 0x40
+    {3, "ऴ"}, {3, "व"}, {3, "श"}, {3, "ष"}, {3, "स"}, {3, "ह"}, {3, "़"}, {3, "ऽ"},  // 0x48
+    {3, "ा"}, {3, "ि"}, {3, "ी"}, {3, "ु"}, {3, "ू"}, {3, "ृ"}, {3, "ॄ"}, {3, "ॅ"},  // 0x50
+    {3, "ॆ"}, {3, "े"}, {3, "ै"}, {3, "ॉ"}, {3, "ॊ"}, {3, "ो"}, {3, "ौ"}, {3, "्"},  // 0x58
+    {3, "ॐ"}, {1, "a"}, {1, "b"}, {1, "c"}, {1, "d"}, {1, "e"}, {1, "f"}, {1, "g"},  // 0x60
+    {1, "h"}, {1, "i"}, {1, "j"}, {1, "k"}, {1, "l"}, {1, "m"}, {1, "n"}, {1, "o"},  // 0x68
+    {1, "p"}, {1, "q"}, {1, "r"}, {1, "s"}, {1, "t"}, {1, "u"}, {1, "v"}, {1, "w"},  // 0x70
+    {1, "x"}, {1, "y"}, {1, "z"}, {3, "ॲ"}, {3, "ॻ"}, {3, "ॼ"}, {3, "ॾ"}, {3, "ॿ"}   // 0x78
+};
+
+// Kannada locking shift table (A.3.7)
+constexpr Gsm7Utf8 KANNADA_LOCKING[128] = {
+    {0, ""}, {3, "ಂ"}, {3, "ಃ"}, {3, "ಅ"}, {3, "ಆ"}, {3, "ಇ"}, {3, "ಈ"}, {3, "ಉ"},  // 0x00
+    {3, "ಊ"}, {3, "ಋ"}, {1, "\n"}, {3, "ಌ"}, {0, ""}, {1, "\r"}, {3, "ಎ"}, {3, "ಏ"},  // 0x08
+    {3, "ಐ"}, {0, ""}, {3, "ಒ"}, {3, "ಓ"}, {3, "ಔ"}, {3, "ಕ"}, {3, "ಖ"}, {3, "ಗ"},  // 0x10
+    {3, "ಘ"}, {3, "ಙ"}, {3, "ಚ"}, {0, ""}, {3, "ಛ"}, {3, "ಜ"}, {3, "ಝ"}, {3, "ಞ"},  // 0x18
+    {1, " "}, {1, "!"}, {3, "ಟ"}, {3, "ಠ"}, {3, "ಡ"}, {3, "ಢ"}, {3, "ಣ"}, {3, "ತ"},  // 0x20
+    {1, ")"}, {1, "("}, {3, "ಥ"}, {3, "ದ"}, {1, ","}, {3, "ಧ"}, {1, "."}, {3, "ನ"},  // 0x28
+    {1, "0"}, {1, "1"}, {1, "2"}, {1, "3"}, {1, "4"}, {1, "5"}, {1, "6"}, {1, "7"},  // 0x30
+    {1, "8"}, {1, "9"}, {1, ":"}, {1, ";"}, {0, ""}, {3, "ಪ"}, {3, "ಫ"}, {1, "?"},  // 0x38
+    {3, "ಬ"}, {3, "ಭ"}, {3, "ಮ"}, {3, "ಯ"}, {3, "ರ"}, {3, "ಱ"}, {3, "ಲ"}, {3, "ಳ"},  // 0x40
+    {0, ""}, {3, "ವ"}, {3, "ಶ"}, {3, "ಷ"}, {3, "ಸ"}, {3, "ಹ"}, {3, "಼"}, {3, "ಽ"},  // 0x48
+    {3, "ಾ"}, {3, "ಿ"}, {3, "ೀ"}, {3, "ು"}, {3, "ೂ"}, {3, "ೃ"}, {3, "ೄ"}, {0, ""},  // 0x50
+    {3, "ೆ"}, {3, "ೇ"}, {3, "ೈ"}, {0, ""}, {3, "ೊ"}, {3, "ೋ"}, {3, "ೌ"}, {3, "್"},  // 0x58
+    {3, "ೕ"}, {1, "a"}, {1, "b"}, {1, "c"}, {1, "d"}, {1, "e"}, {1, "f"}, {1, "g"},  // 0x60
+    {1, "h"}, {1, "i"}, {1, "j"}, {1, "k"}, {1, "l"}, {1, "m"}, {1, "n"}, {1, "o"},  // 0x68
+    {1, "p"}, {1, "q"}, {1, "r"}, {1, "s"}, {1, "t"}, {1, "u"}, {1, "v"}, {1, "w"},  // 0x70
+    {1, "x"}, {1, "y"}, {1, "z"}, {3, "ೖ"}, {3, "ೠ"}, {3, "ೡ"}, {3, "ೢ"}, {3, "ೣ"}   // 0x78
+};
+
+// Malayalam locking shift table (A.3.8)
+constexpr Gsm7Utf8 MALAYALAM_LOCKING[128] = {
+    {0, ""}, {3, "ം"}, {3, "ഃ"}, {3, "അ"}, {3, "ആ"}, {3, "ഇ"}, {3, "ഈ"}, {3, "ഉ"},  // 0x00
+    {3, "ഊ"}, {3, "ഋ"}, {1, "\n"}, {3, "ഌ"}, {0, ""}, {1, "\r"}, {3, "എ"}, {3, "ഏ"},  // 0x08
+    {3, "ഐ"}, {0, ""}, {3, "ഒ"}, {3, "ഓ"}, {3, "ഔ"}, {3, "ക"}, {3, "ഖ"}, {3, "ഗ"},  // 0x10
+    {3, "ഘ"}, {3, "ങ"}, {3, "ച"}, {0, ""}, {3, "ഛ"}, {3, "ജ"}, {3, "ഝ"}, {3, "ഞ"},  // 0x18
+    {1, " "}, {1, "!"}, {3, "ട"}, {3, "ഠ"}, {3, "ഡ"}, {3, "ഢ"}, {3, "ണ"}, {3, "ത"},  // 0x20
+    {1, ")"}, {1, "("}, {3, "ഥ"}, {3, "ദ"}, {1, ","}, {3, "ധ"}, {1, "."}, {3, "ന"},  // 0x28
+    {1, "0"}, {1, "1"}, {1, "2"}, {1, "3"}, {1, "4"}, {1, "5"}, {1, "6"}, {1, "7"},  // 0x30
+    {1, "8"}, {1, "9"}, {1, ":"}, {1, ";"}, {0, ""}, {3, "പ"}, {3, "ഫ"}, {1, "?"},  // 0x38
+    {3, "ബ"}, {3, "ഭ"}, {3, "മ"}, {3, "യ"}, {3, "ര"}, {3, "റ"}, {3, "ല"}, {3, "ള"},  // 0x40
+    {3, "ഴ"}, {3, "വ"}, {3, "ശ"}, {3, "ഷ"}, {3, "സ"}, {3, "ഹ"}, {0, ""}, {3, "ഽ"},  // 0x48
+    {3, "ാ"}, {3, "ി"}, {3, "ീ"}, {3, "ു"}, {3, "ൂ"}, {3, "ൃ"}, {3, "ൄ"}, {0, ""},  // 0x50
+    {3, "െ"}, {3, "േ"}, {3, "ൈ"}, {0, ""}, {3, "ൊ"}, {3, "ോ"}, {3, "ൌ"}, {3, "്"},  // 0x58
+    {3, "ൗ"}, {1, "a"}, {1, "b"}, {1, "c"}, {1, "d"}, {1, "e"}, {1, "f"}, {1, "g"},  // 0x60
+    {1, "h"}, {1, "i"}, {1, "j"}, {1, "k"}, {1, "l"}, {1, "m"}, {1, "n"}, {1, "o"},  // 0x68
+    {1, "p"}, {1, "q"}, {1, "r"}, {1, "s"}, {1, "t"}, {1, "u"}, {1, "v"}, {1, "w"},  // 0x70
+    {1, "x"}, {1, "y"}, {1, "z"}, {3, "ൠ"}, {3, "ൡ"}, {3, "ൢ"}, {3, "ൣ"}, {3, "൹"}   // 0x78
+};
+
+// Oriya locking shift table (A.3.9)
+constexpr Gsm7Utf8 ORIYA_LOCKING[128] = {
+    {3, "ଁ"}, {3, "ଂ"}, {3, "ଃ"}, {3, "ଅ"}, {3, "ଆ"}, {3, "ଇ"}, {3, "ଈ"}, {3, "ଉ"},  // 0x00
+    {3, "ଊ"}, {3, "ଋ"}, {1, "\n"}, {3, "ଌ"}, {0, ""}, {1, "\r"}, {0, ""}, {3, "ଏ"},  // 0x08
+    {3, "ଐ"}, {0, ""}, {0, ""}, {3, "ଓ"}, {3, "ଔ"}, {3, "କ"}, {3, "ଖ"}, {3, "ଗ"},  // 0x10
+    {3, "ଘ"}, {3, "ଙ"}, {3, "ଚ"}, {0, ""}, {3, "ଛ"}, {3, "ଜ"}, {3, "ଝ"}, {3, "ଞ"},  // 0x18
+    {1, " "}, {1, "!"}, {3, "ଟ"}, {3, "ଠ"}, {3, "ଡ"}, {3, "ଢ"}, {3, "ଣ"}, {3, "ତ"},  // 0x20
+    {1, ")"}, {1, "("}, {3, "ଥ"}, {3, "ଦ"}, {1, ","}, {3, "ଧ"}, {1, "."}, {3, "ନ"},  // 0x28
+    {1, "0"}, {1, "1"}, {1, "2"}, {1, "3"}, {1, "4"}, {1, "5"}, {1, "6"}, {1, "7"},  // 0x30
+    {1, "8"}, {1, "9"}, {1, ":"}, {1, ";"}, {0, ""}, {3, "ପ"}, {3, "ଫ"}, {1, "?"},  // 0x38
+    {3, "ବ"}, {3, "ଭ"}, {3, "ମ"}, {3, "ଯ"}, {3, "ର"}, {0, ""}, {3, "ଲ"}, {3, "ଳ"},  // 0x40
+    {0, ""}, {3, "ଵ"}, {3, "ଶ"}, {3, "ଷ"}, {3, "ସ"}, {3, "ହ"}, {3, "଼"}, {3, "ଽ"},  // 0x48
+    {3, "ା"}, {3, "ି"}, {3, "ୀ"}, {3, "ୁ"}, {3, "ୂ"}, {3, "ୃ"}, {3, "ୄ"}, {0, ""},  // 0x50
+    {0, ""}, {3, "େ"}, {3, "ୈ"}, {0, ""}, {0, ""}, {3, "ୋ"}, {3, "ୌ"}, {3, "୍"},  // 0x58
+    {3, "ୖ"}, {1, "a"}, {1, "b"}, {1, "c"}, {1, "d"}, {1, "e"}, {1, "f"}, {1, "g"},  // 0x60
+    {1, "h"}, {1, "i"}, {1, "j"}, {1, "k"}, {1, "l"}, {1, "m"}, {1, "n"}, {1, "o"},  // 0x68
+    {1, "p"}, {1, "q"}, {1, "r"}, {1, "s"}, {1, "t"}, {1, "u"}, {1, "v"}, {1, "w"},  // 0x70
+    {1, "x"}, {1, "y"}, {1, "z"}, {3, "ୗ"}, {3, "ୠ"}, {3, "ୡ"}, {3, "ୢ"}, {3, "ୣ"}   // 0x78
+};
+
+// Punjabi locking shift table (A.3.10)
+constexpr Gsm7Utf8 PUNJABI_LOCKING[128] = {
+    {3, "ਁ"}, {3, "ਂ"}, {3, "ਃ"}, {3, "ਅ"}, {3, "ਆ"}, {3, "ਇ"}, {3, "ਈ"}, {3, "ਉ"},  // 0x00
+    {3, "ਊ"}, {0, ""}, {1, "\n"}, {0, ""}, {0, ""}, {1, "\r"}, {0, ""}, {3, "ਏ"},  // 0x08
+    {3, "ਐ"}, {0, ""}, {0, ""}, {3, "ਓ"}, {3, "ਔ"}, {3, "ਕ"}, {3, "ਖ"}, {3, "ਗ"},  // 0x10
+    {3, "ਘ"}, {3, "ਙ"}, {3, "ਚ"}, {0, ""}, {3, "ਛ"}, {3, "ਜ"}, {3, "ਝ"}, {3, "ਞ"},  // 0x18
+    {1, " "}, {1, "!"}, {3, "ਟ"}, {3, "ਠ"}, {3, "ਡ"}, {3, "ਢ"}, {3, "ਣ"}, {3, "ਤ"},  // 0x20
+    {1, ")"}, {1, "("}, {3, "ਥ"}, {3, "ਦ"}, {1, ","}, {3, "ਧ"}, {1, "."}, {3, "ਨ"},  // 0x28
+    {1, "0"}, {1, "1"}, {1, "2"}, {1, "3"}, {1, "4"}, {1, "5"}, {1, "6"}, {1, "7"},  // 0x30
+    {1, "8"}, {1, "9"}, {1, ":"}, {1, ";"}, {0, ""}, {3, "ਪ"}, {3, "ਫ"}, {1, "?"},  // 0x38
+    {3, "ਬ"}, {3, "ਭ"}, {3, "ਮ"}, {3, "ਯ"}, {3, "ਰ"}, {0, ""}, {3, "ਲ"}, {3, "ਲ਼"},  // 0x40
+    {0, ""}, {3, "ਵ"}, {3, "ਸ਼"}, {0, ""}, {3, "ਸ"}, {3, "ਹ"}, {3, "਼"}, {0, ""},  // 0x48
+    {3, "ਾ"}, {3, "ਿ"}, {3, "ੀ"}, {3, "ੁ"}, {3, "ੂ"}, {0, ""}, {0, ""}, {0, ""},  // 0x50
+    {0, ""}, {3, "ੇ"}, {3, "ੈ"}, {0, ""}, {0, ""}, {3, "ੋ"}, {3, "ੌ"}, {3, "੍"},  // 0x58
+    {3, "ੑ"}, {1, "a"}, {1, "b"}, {1, "c"}, {1, "d"}, {1, "e"}, {1, "f"}, {1, "g"},  // 0x60
+    {1, "h"}, {1, "i"}, {1, "j"}, {1, "k"}, {1, "l"}, {1, "m"}, {1, "n"}, {1, "o"},  // 0x68
+    {1, "p"}, {1, "q"}, {1, "r"}, {1, "s"}, {1, "t"}, {1, "u"}, {1, "v"}, {1, "w"},  // 0x70
+    {1, "x"}, {1, "y"}, {1, "z"}, {3, "ੰ"}, {3, "ੱ"}, {3, "ੲ"}, {3, "ੳ"}, {3, "ੴ"}   // 0x78
+};
+
+// Tamil locking shift table (A.3.11)
+constexpr Gsm7Utf8 TAMIL_LOCKING[128] = {
+    {0, ""}, {3, "ஂ"}, {3, "ஃ"}, {3, "அ"}, {3, "ஆ"}, {3, "இ"}, {3, "ஈ"}, {3, "உ"},  // 0x00
+    {3, "ஊ"}, {0, ""}, {1, "\n"}, {0, ""}, {0, ""}, {1, "\r"}, {3, "எ"}, {3, "ஏ"},  // 0x08
+    {3, "ஐ"}, {0, ""}, {3, "ஒ"}, {3, "ஓ"}, {3, "ஔ"}, {3, "க"}, {0, ""}, {0, ""},  // 0x10
+    {0, ""}, {3, "ங"}, {3, "ச"}, {0, ""}, {0, ""}, {3, "ஜ"}, {0, ""}, {3, "ஞ"},  // 0x18
+    {1, " "}, {1, "!"}, {3, "ட"}, {0, ""}, {0, ""}, {0, ""}, {3, "ண"}, {3, "த"},  // 0x20
+    {1, ")"}, {1, "("}, {0, ""}, {0, ""}, {1, ","}, {0, ""}, {1, "."}, {3, "ந"},  // 0x28
+    {1, "0"}, {1, "1"}, {1, "2"}, {1, "3"}, {1, "4"}, {1, "5"}, {1, "6"}, {1, "7"},  // 0x30
+    {1, "8"}, {1, "9"}, {1, ":"}, {1, ";"}, {3, "ன"}, {3, "ப"}, {0, ""}, {1, "?"},  // 0x38
+    {0, ""}, {0, ""}, {3, "ம"}, {3, "ய"}, {3, "ர"}, {3, "ற"}, {3, "ல"}, {3, "ள"},  // 0x40
+    {3, "ழ"}, {3, "வ"}, {3, "ஶ"}, {3, "ஷ"}, {3, "ஸ"}, {3, "ஹ"}, {0, ""}, {0, ""},  // 0x48
+    {3, "ா"}, {3, "ி"}, {3, "ீ"}, {3, "ு"}, {3, "ூ"}, {0, ""}, {0, ""}, {0, ""},  // 0x50
+    {3, "ெ"}, {3, "ே"}, {3, "ை"}, {0, ""}, {3, "ொ"}, {3, "ோ"}, {3, "ௌ"}, {3, "்"},  // 0x58
+    {3, "ௐ"}, {1, "a"}, {1, "b"}, {1, "c"}, {1, "d"}, {1, "e"}, {1, "f"}, {1, "g"},  // 0x60
+    {1, "h"}, {1, "i"}, {1, "j"}, {1, "k"}, {1, "l"}, {1, "m"}, {1, "n"}, {1, "o"},  // 0x68
+    {1, "p"}, {1, "q"}, {1, "r"}, {1, "s"}, {1, "t"}, {1, "u"}, {1, "v"}, {1, "w"},  // 0x70
+    {1, "x"}, {1, "y"}, {1, "z"}, {3, "ௗ"}, {3, "௰"}, {3, "௱"}, {3, "௲"}, {3, "௹"}   // 0x78
+};
+
+// Telugu locking shift table (A.3.12)
+constexpr Gsm7Utf8 TELUGU_LOCKING[128] = {
+    {3, "ఁ"}, {3, "ం"}, {3, "ః"}, {3, "అ"}, {3, "ఆ"}, {3, "ఇ"}, {3, "ఈ"}, {3, "ఉ"},  // 0x00
+    {3, "ఊ"}, {3, "ఋ"}, {1, "\n"}, {3, "ఌ"}, {0, ""}, {1, "\r"}, {3, "ఎ"}, {3, "ఏ"},  // 0x08
+    {3, "ఐ"}, {0, ""}, {3, "ఒ"}, {3, "ఓ"}, {3, "ఔ"}, {3, "క"}, {3, "ఖ"}, {3, "గ"},  // 0x10
+    {3, "ఘ"}, {3, "ఙ"}, {3, "చ"}, {0, ""}, {3, "ఛ"}, {3, "జ"}, {3, "ఝ"}, {3, "ఞ"},  // 0x18
+    {1, " "}, {1, "!"}, {3, "ట"}, {3, "ఠ"}, {3, "డ"}, {3, "ఢ"}, {3, "ణ"}, {3, "త"},  // 0x20
+    {1, ")"}, {1, "("}, {3, "థ"}, {3, "ద"}, {1, ","}, {3, "ధ"}, {1, "."}, {3, "న"},  // 0x28
+    {1, "0"}, {1, "1"}, {1, "2"}, {1, "3"}, {1, "4"}, {1, "5"}, {1, "6"}, {1, "7"},  // 0x30
+    {1, "8"}, {1, "9"}, {1, ":"}, {1, ";"}, {0, ""}, {3, "ప"}, {3, "ఫ"}, {1, "?"},  // 0x38
+    {3, "బ"}, {3, "భ"}, {3, "మ"}, {3, "య"}, {3, "ర"}, {3, "ఱ"}, {3, "ల"}, {3, "ళ"},  // 0x40
+    {0, ""}, {3, "వ"}, {3, "శ"}, {3, "ష"}, {3, "స"}, {3, "హ"}, {0, ""}, {3, "ఽ"},  // 0x48
+    {3, "ా"}, {3, "ి"}, {3, "ీ"}, {3, "ు"}, {3, "ూ"}, {3, "ృ"}, {3, "ౄ"}, {0, ""},  // 0x50
+    {3, "ె"}, {3, "ే"}, {3, "ై"}, {0, ""}, {3, "ొ"}, {3, "ో"}, {3, "ౌ"}, {3, "్"},  // 0x58
+    {3, "ౕ"}, {1, "a"}, {1, "b"}, {1, "c"}, {1, "d"}, {1, "e"}, {1, "f"}, {1, "g"},  // 0x60
+    {1, "h"}, {1, "i"}, {1, "j"}, {1, "k"}, {1, "l"}, {1, "m"}, {1, "n"}, {1, "o"},  // 0x68
+    {1, "p"}, {1, "q"}, {1, "r"}, {1, "s"}, {1, "t"}, {1, "u"}, {1, "v"}, {1, "w"},  // 0x70
+    {1, "x"}, {1, "y"}, {1, "z"}, {3, "ౖ"}, {3, "ౠ"}, {3, "ౡ"}, {3, "ౢ"}, {3, "ౣ"}   // 0x78
+};
+
+// Urdu locking shift table (A.3.13)
+constexpr Gsm7Utf8 URDU_LOCKING[128] = {
+    {2, "ا"}, {2, "آ"}, {2, "ب"}, {2, "ٻ"}, {2, "ڀ"}, {2, "پ"}, {2, "ڦ"}, {2, "ت"},  // 0x00
+    {2, "ۂ"}, {2, "ٿ"}, {1, "\n"}, {2, "ٹ"}, {2, "ٽ"}, {1, "\r"}, {2, "ٺ"}, {2, "ټ"},  // 0x08
+    {2, "ث"}, {2, "ج"}, {2, "ځ"}, {2, "ڄ"}, {2, "ڃ"}, {2, "څ"}, {2, "چ"}, {2, "ڇ"},  // 0x10
+    {2, "ح"}, {2, "خ"}, {2, "د"}, {0, ""}, {2, "ڌ"}, {2, "ڈ"}, {2, "ډ"}, {2, "ڊ"},  // 0x18
+    {1, " "}, {1, "!"}, {2, "ڏ"}, {2, "ڍ"}, {2, "ذ"}, {2, "ر"}, {2, "ڑ"}, {2, "ړ"},  // 0x20
+    {1, ")"}, {1, "("}, {2, "ڙ"}, {2, "ز"}, {1, ","}, {2, "ږ"}, {1, "."}, {2, "ژ"},  // 0x28
+    {1, "0"}, {1, "1"}, {1, "2"}, {1, "3"}, {1, "4"}, {1, "5"}, {1, "6"}, {1, "7"},  // 0x30
+    {1, "8"}, {1, "9"}, {1, ":"}, {1, ";"}, {2, "ښ"}, {2, "س"}, {2, "ش"}, {1, "?"},  // 0x38
+    {2, "ص"}, {2, "ض"}, {2, "ط"}, {2, "ظ"}, {2, "ع"}, {2, "ف"}, {2, "ق"}, {2, "ک"},  // 0x40
+    {2, "ڪ"}, {2, "ګ"}, {2, "گ"}, {2, "ڳ"}, {2, "ڱ"}, {2, "ل"}, {2, "م"}, {2, "ن"},  // 0x48
+    {2, "ں"}, {2, "ڻ"}, {2, "ڼ"}, {2, "و"}, {2, "ۄ"}, {2, "ە"}, {2, "ہ"}, {2, "ھ"},  // 0x50
+    {2, "ء"}, {2, "ی"}, {2, "ې"}, {2, "ے"}, {2, "ٍ"}, {2, "ِ"}, {2, "ُ"}, {2, "ٗ"},  // 0x58
+    {2, "ٔ"}, {1, "a"}, {1, "b"}, {1, "c"}, {1, "d"}, {1, "e"}, {1, "f"}, {1, "g"},  // 0x60
+    {1, "h"}, {1, "i"}, {1, "j"}, {1, "k"}, {1, "l"}, {1, "m"}, {1, "n"}, {1, "o"},  // 0x68
+    {1, "p"}, {1, "q"}, {1, "r"}, {1, "s"}, {1, "t"}, {1, "u"}, {1, "v"}, {1, "w"},  // 0x70
+    {1, "x"}, {1, "y"}, {1, "z"}, {2, "ٕ"}, {2, "ّ"}, {2, "ٓ"}, {2, "ٖ"}, {2, "ٰ"}   // 0x78
+};
+
+// Bengali single shift table (A.2.4)
+constexpr Gsm7Utf8 BENGALI_SINGLE[128] = {
+    {1, "@"}, {2, "£"}, {1, "$"}, {2, "¥"}, {2, "¿"}, {1, "\""}, {2, "¤"}, {1, "%"},  // 0x00
+    {1, "&"}, {1, "'"}, {1, "\f"}, {1, "*"}, {1, "+"}, {0, ""}, {1, "-"}, {1, "/"},  // 0x08
+    {1, "<"}, {1, "="}, {1, ">"}, {2, "¡"}, {1, "^"}, {2, "¡"}, {1, "_"}, {1, "#"},  // 0x10
+    {1, "*"}, {3, "০"}, {3, "১"}, {0, ""}, {3, "২"}, {3, "৩"}, {3, "৪"}, {3, "৫"},  // 0x18
+    {3, "৬"}, {3, "৭"}, {3, "৮"}, {3, "৯"}, {3, "য়"}, {3, "ৠ"}, {3, "ৡ"}, {3, "ৢ"},  // 0x20
+    {1, "{"}, {1, "}"}, {3, "ৣ"}, {3, "৲"}, {3, "৳"}, {3, "৴"}, {3, "৵"}, {1, "\\"},  // 0x28
+    {3, "৶"}, {3, "৷"}, {3, "৸"}, {3, "৹"}, {3, "৺"}, {0, ""}, {0, ""}, {0, ""},  // 0x30
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "["}, {1, "~"}, {1, "]"}, {0, ""},  // 0x38
+    {1, "|"}, {1, "A"}, {1, "B"}, {1, "C"}, {1, "D"}, {1, "E"}, {1, "F"}, {1, "G"},  // 0x40
+    {1, "H"}, {1, "I"}, {1, "J"}, {1, "K"}, {1, "L"}, {1, "M"}, {1, "N"}, {1, "O"},  // 0x48
+    {1, "P"}, {1, "Q"}, {1, "R"}, {1, "S"}, {1, "T"}, {1, "U"}, {1, "V"}, {1, "W"},  // 0x50
+    {1, "X"}, {1, "Y"}, {1, "Z"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x58
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {3, "€"}, {0, ""}, {0, ""},  // 0x60
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x68
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x70
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}   // 0x78
+};
+
+// Gujarati single shift table (A.2.5)
+constexpr Gsm7Utf8 GUJARATI_SINGLE[128] = {
+    {1, "@"}, {2, "£"}, {1, "$"}, {2, "¥"}, {2, "¿"}, {1, "\""}, {2, "¤"}, {1, "%"},  // 0x00
+    {1, "&"}, {1, "'"}, {1, "\f"}, {1, "*"}, {1, "+"}, {0, ""}, {1, "-"}, {1, "/"},  // 0x08
+    {1, "<"}, {1, "="}, {1, ">"}, {2, "¡"}, {1, "^"}, {2, "¡"}, {1, "_"}, {1, "#"},  // 0x10
+    {1, "*"}, {3, "।"}, {3, "॥"}, {0, ""}, {3, "૦"}, {3, "૧"}, {3, "૨"}, {3, "૩"},  // 0x18
+    {3, "૪"}, {3, "૫"}, {3, "૬"}, {3, "૭"}, {3, "૮"}, {3, "૯"}, {0, ""}, {0, ""},  // 0x20
+    {1, "{"}, {1, "}"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "\\"},  // 0x28
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x30
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "["}, {1, "~"}, {1, "]"}, {0, ""},  // 0x38
+    {1, "|"}, {1, "A"}, {1, "B"}, {1, "C"}, {1, "D"}, {1, "E"}, {1, "F"}, {1, "G"},  // 0x40
+    {1, "H"}, {1, "I"}, {1, "J"}, {1, "K"}, {1, "L"}, {1, "M"}, {1, "N"}, {1, "O"},  // 0x48
+    {1, "P"}, {1, "Q"}, {1, "R"}, {1, "S"}, {1, "T"}, {1, "U"}, {1, "V"}, {1, "W"},  // 0x50
+    {1, "X"}, {1, "Y"}, {1, "Z"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x58
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {3, "€"}, {0, ""}, {0, ""},  // 0x60
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x68
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x70
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}   // 0x78
+};
+
+// Hindi single shift table (A.2.6)
+constexpr Gsm7Utf8 HINDI_SINGLE[128] = {
+    {1, "@"}, {2, "£"}, {1, "$"}, {2, "¥"}, {2, "¿"}, {1, "\""}, {2, "¤"}, {1, "%"},  // 0x00
+    {1, "&"}, {1, "'"}, {1, "\f"}, {1, "*"}, {1, "+"}, {0, ""}, {1, "-"}, {1, "/"},  // 0x08
+    {1, "<"}, {1, "="}, {1, ">"}, {2, "¡"}, {1, "^"}, {2, "¡"}, {1, "_"}, {1, "#"},  // 0x10
+    {1, "*"}, {3, "।"}, {3, "॥"}, {0, ""}, {3, "०"}, {3, "१"}, {3, "२"}, {3, "३"},  // 0x18
+    {3, "४"}, {3, "५"}, {3, "६"}, {3, "७"}, {3, "८"}, {3, "९"}, {3, "॑"}, {3, "॒"},  // 0x20
+    {1, "{"}, {1, "}"}, {3, "॓"}, {3, "॔"}, {3, "क़"}, {3, "ख़"}, {3, "ग़"}, {1, "\\"},  // 0x28
+    {3, "ज़"}, {3, "ड़"}, {3, "ढ़"}, {3, "फ़"}, {3, "य़"}, {3, "ॠ"}, {3, "ॡ"}, {3, "ॢ"},  // 0x30
+    {3, "ॣ"}, {3, "॰"}, {3, "ॱ"}, {0, ""}, {1, "["}, {1, "~"}, {1, "]"}, {0, ""},  // 0x38
+    {1, "|"}, {1, "A"}, {1, "B"}, {1, "C"}, {1, "D"}, {1, "E"}, {1, "F"}, {1, "G"},  // 0x40
+    {1, "H"}, {1, "I"}, {1, "J"}, {1, "K"}, {1, "L"}, {1, "M"}, {1, "N"}, {1, "O"},  // 0x48
+    {1, "P"}, {1, "Q"}, {1, "R"}, {1, "S"}, {1, "T"}, {1, "U"}, {1, "V"}, {1, "W"},  // 0x50
+    {1, "X"}, {1, "Y"}, {1, "Z"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x58
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {3, "€"}, {0, ""}, {0, ""},  // 0x60
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x68
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x70
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}   // 0x78
+};
+
+// Kannada single shift table (A.2.7)
+constexpr Gsm7Utf8 KANNADA_SINGLE[128] = {
+    {1, "@"}, {2, "£"}, {1, "$"}, {2, "¥"}, {2, "¿"}, {1, "\""}, {2, "¤"}, {1, "%"},  // 0x00
+    {1, "&"}, {1, "'"}, {1, "\f"}, {1, "*"}, {1, "+"}, {0, ""}, {1, "-"}, {1, "/"},  // 0x08
+    {1, "<"}, {1, "="}, {1, ">"}, {2, "¡"}, {1, "^"}, {2, "¡"}, {1, "_"}, {1, "#"},  // 0x10
+    {1, "*"}, {3, "।"}, {3, "॥"}, {0, ""}, {3, "೦"}, {3, "೧"}, {3, "೨"}, {3, "೩"},  // 0x18
+    {3, "೪"}, {3, "೫"}, {3, "೬"}, {3, "೭"}, {3, "೮"}, {3, "೯"}, {3, "ೞ"}, {3, "ೱ"},  // 0x20
+    {1, "{"}, {1, "}"}, {3, "ೲ"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "\\"},  // 0x28
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x30
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "["}, {1, "~"}, {1, "]"}, {0, ""},  // 0x38
+    {1, "|"}, {1, "A"}, {1, "B"}, {1, "C"}, {1, "D"}, {1, "E"}, {1, "F"}, {1, "G"},  // 0x40
+    {1, "H"}, {1, "I"}, {1, "J"}, {1, "K"}, {1, "L"}, {1, "M"}, {1, "N"}, {1, "O"},  // 0x48
+    {1, "P"}, {1, "Q"}, {1, "R"}, {1, "S"}, {1, "T"}, {1, "U"}, {1, "V"}, {1, "W"},  // 0x50
+    {1, "X"}, {1, "Y"}, {1, "Z"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x58
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {3, "€"}, {0, ""}, {0, ""},  // 0x60
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x68
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x70
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}   // 0x78
+};
+
+// Malayalam single shift table (A.2.8)
+constexpr Gsm7Utf8 MALAYALAM_SINGLE[128] = {
+    {1, "@"}, {2, "£"}, {1, "$"}, {2, "¥"}, {2, "¿"}, {1, "\""}, {2, "¤"}, {1, "%"},  // 0x00
+    {1, "&"}, {1, "'"}, {1, "\f"}, {1, "*"}, {1, "+"}, {0, ""}, {1, "-"}, {1, "/"},  // 0x08
+    {1, "<"}, {1, "="}, {1, ">"}, {2, "¡"}, {1, "^"}, {2, "¡"}, {1, "_"}, {1, "#"},  // 0x10
+    {1, "*"}, {3, "।"}, {3, "॥"}, {0, ""}, {3, "൦"}, {3, "൧"}, {3, "൨"}, {3, "൩"},  // 0x18
+    {3, "൪"}, {3, "൫"}, {3, "൬"}, {3, "൭"}, {3, "൮"}, {3, "൯"}, {3, "൰"}, {3, "൱"},  // 0x20
+    {1, "{"}, {1, "}"}, {3, "൲"}, {3, "൳"}, {3, "൴"}, {3, "൵"}, {3, "ൺ"}, {1, "\\"},  // 0x28
+    {3, "ൻ"}, {3, "ർ"}, {3, "ൽ"}, {3, "ൾ"}, {3, "ൿ"}, {0, ""}, {0, ""}, {0, ""},  // 0x30
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "["}, {1, "~"}, {1, "]"}, {0, ""},  // 0x38
+    {1, "|"}, {1, "A"}, {1, "B"}, {1, "C"}, {1, "D"}, {1, "E"}, {1, "F"}, {1, "G"},  // 0x40
+    {1, "H"}, {1, "I"}, {1, "J"}, {1, "K"}, {1, "L"}, {1, "M"}, {1, "N"}, {1, "O"},  // 0x48
+    {1, "P"}, {1, "Q"}, {1, "R"}, {1, "S"}, {1, "T"}, {1, "U"}, {1, "V"}, {1, "W"},  // 0x50
+    {1, "X"}, {1, "Y"}, {1, "Z"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x58
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {3, "€"}, {0, ""}, {0, ""},  // 0x60
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x68
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x70
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}   // 0x78
+};
+
+// Oriya single shift table (A.2.9)
+constexpr Gsm7Utf8 ORIYA_SINGLE[128] = {
+    {1, "@"}, {2, "£"}, {1, "$"}, {2, "¥"}, {2, "¿"}, {1, "\""}, {2, "¤"}, {1, "%"},  // 0x00
+    {1, "&"}, {1, "'"}, {1, "\f"}, {1, "*"}, {1, "+"}, {0, ""}, {1, "-"}, {1, "/"},  // 0x08
+    {1, "<"}, {1, "="}, {1, ">"}, {2, "¡"}, {1, "^"}, {2, "¡"}, {1, "_"}, {1, "#"},  // 0x10
+    {1, "*"}, {3, "।"}, {3, "॥"}, {0, ""}, {3, "୦"}, {3, "୧"}, {3, "୨"}, {3, "୩"},  // 0x18
+    {3, "୪"}, {3, "୫"}, {3, "୬"}, {3, "୭"}, {3, "୮"}, {3, "୯"}, {3, "ଡ଼"}, {3, "ଢ଼"},  // 0x20
+    {1, "{"}, {1, "}"}, {3, "ୟ"}, {3, "୰"}, {3, "ୱ"}, {0, ""}, {0, ""}, {1, "\\"},  // 0x28
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x30
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "["}, {1, "~"}, {1, "]"}, {0, ""},  // 0x38
+    {1, "|"}, {1, "A"}, {1, "B"}, {1, "C"}, {1, "D"}, {1, "E"}, {1, "F"}, {1, "G"},  // 0x40
+    {1, "H"}, {1, "I"}, {1, "J"}, {1, "K"}, {1, "L"}, {1, "M"}, {1, "N"}, {1, "O"},  // 0x48
+    {1, "P"}, {1, "Q"}, {1, "R"}, {1, "S"}, {1, "T"}, {1, "U"}, {1, "V"}, {1, "W"},  // 0x50
+    {1, "X"}, {1, "Y"}, {1, "Z"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x58
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {3, "€"}, {0, ""}, {0, ""},  // 0x60
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x68
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x70
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}   // 0x78
+};
+
+// Punjabi single shift table (A.2.10)
+constexpr Gsm7Utf8 PUNJABI_SINGLE[128] = {
+    {1, "@"}, {2, "£"}, {1, "$"}, {2, "¥"}, {2, "¿"}, {1, "\""}, {2, "¤"}, {1, "%"},  // 0x00
+    {1, "&"}, {1, "'"}, {1, "\f"}, {1, "*"}, {1, "+"}, {0, ""}, {1, "-"}, {1, "/"},  // 0x08
+    {1, "<"}, {1, "="}, {1, ">"}, {2, "¡"}, {1, "^"}, {2, "¡"}, {1, "_"}, {1, "#"},  // 0x10
+    {1, "*"}, {3, "।"}, {3, "॥"}, {0, ""}, {3, "੦"}, {3, "੧"}, {3, "੨"}, {3, "੩"},  // 0x18
+    {3, "੪"}, {3, "੫"}, {3, "੬"}, {3, "੭"}, {3, "੮"}, {3, "੯"}, {3, "ਖ਼"}, {3, "ਗ਼"},  // 0x20
+    {1, "{"}, {1, "}"}, {3, "ਜ਼"}, {3, "ੜ"}, {3, "ਫ਼"}, {3, "ੵ"}, {0, ""}, {1, "\\"},  // 0x28
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x30
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "["}, {1, "~"}, {1, "]"}, {0, ""},  // 0x38
+    {1, "|"}, {1, "A"}, {1, "B"}, {1, "C"}, {1, "D"}, {1, "E"}, {1, "F"}, {1, "G"},  // 0x40
+    {1, "H"}, {1, "I"}, {1, "J"}, {1, "K"}, {1, "L"}, {1, "M"}, {1, "N"}, {1, "O"},  // 0x48
+    {1, "P"}, {1, "Q"}, {1, "R"}, {1, "S"}, {1, "T"}, {1, "U"}, {1, "V"}, {1, "W"},  // 0x50
+    {1, "X"}, {1, "Y"}, {1, "Z"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x58
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {3, "€"}, {0, ""}, {0, ""},  // 0x60
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x68
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x70
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}   // 0x78
+};
+
+// Tamil single shift table (A.2.11)
+constexpr Gsm7Utf8 TAMIL_SINGLE[128] = {
+    {1, "@"}, {2, "£"}, {1, "$"}, {2, "¥"}, {2, "¿"}, {1, "\""}, {2, "¤"}, {1, "%"},  // 0x00
+    {1, "&"}, {1, "'"}, {1, "\f"}, {1, "*"}, {1, "+"}, {0, ""}, {1, "-"}, {1, "/"},  // 0x08
+    {1, "<"}, {1, "="}, {1, ">"}, {2, "¡"}, {1, "^"}, {2, "¡"}, {1, "_"}, {1, "#"},  // 0x10
+    {1, "*"}, {3, "।"}, {3, "॥"}, {0, ""}, {3, "௦"}, {3, "௧"}, {3, "௨"}, {3, "௩"},  // 0x18
+    {3, "௪"}, {3, "௫"}, {3, "௬"}, {3, "௭"}, {3, "௮"}, {3, "௯"}, {3, "௳"}, {3, "௴"},  // 0x20
+    {1, "{"}, {1, "}"}, {3, "௵"}, {3, "௶"}, {3, "௷"}, {3, "௸"}, {3, "௺"}, {1, "\\"},  // 0x28
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x30
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "["}, {1, "~"}, {1, "]"}, {0, ""},  // 0x38
+    {1, "|"}, {1, "A"}, {1, "B"}, {1, "C"}, {1, "D"}, {1, "E"}, {1, "F"}, {1, "G"},  // 0x40
+    {1, "H"}, {1, "I"}, {1, "J"}, {1, "K"}, {1, "L"}, {1, "M"}, {1, "N"}, {1, "O"},  // 0x48
+    {1, "P"}, {1, "Q"}, {1, "R"}, {1, "S"}, {1, "T"}, {1, "U"}, {1, "V"}, {1, "W"},  // 0x50
+    {1, "X"}, {1, "Y"}, {1, "Z"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x58
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {3, "€"}, {0, ""}, {0, ""},  // 0x60
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x68
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x70
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}   // 0x78
+};
+
+// Telugu single shift table (A.2.12)
+constexpr Gsm7Utf8 TELUGU_SINGLE[128] = {
+    {1, "@"}, {2, "£"}, {1, "$"}, {2, "¥"}, {2, "¿"}, {1, "\""}, {2, "¤"}, {1, "%"},  // 0x00
+    {1, "&"}, {1, "'"}, {1, "\f"}, {1, "*"}, {1, "+"}, {0, ""}, {1, "-"}, {1, "/"},  // 0x08
+    {1, "<"}, {1, "="}, {1, ">"}, {2, "¡"}, {1, "^"}, {2, "¡"}, {1, "_"}, {1, "#"},  // 0x10
+    {1, "*"}, {0, ""}, {0, ""}, {0, ""}, {3, "౦"}, {3, "౧"}, {3, "౨"}, {3, "౩"},  // 0x18
+    {3, "౪"}, {3, "౫"}, {3, "౬"}, {3, "౭"}, {3, "౮"}, {3, "౯"}, {3, "ౘ"}, {3, "ౙ"},  // 0x20
+    {1, "{"}, {1, "}"}, {3, "౸"}, {3, "౹"}, {3, "౺"}, {3, "౻"}, {3, "౼"}, {1, "\\"},  // 0x28
+    {3, "౽"}, {3, "౾"}, {3, "౿"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x30
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {1, "["}, {1, "~"}, {1, "]"}, {0, ""},  // 0x38
+    {1, "|"}, {1, "A"}, {1, "B"}, {1, "C"}, {1, "D"}, {1, "E"}, {1, "F"}, {1, "G"},  // 0x40
+    {1, "H"}, {1, "I"}, {1, "J"}, {1, "K"}, {1, "L"}, {1, "M"}, {1, "N"}, {1, "O"},  // 0x48
+    {1, "P"}, {1, "Q"}, {1, "R"}, {1, "S"}, {1, "T"}, {1, "U"}, {1, "V"}, {1, "W"},  // 0x50
+    {1, "X"}, {1, "Y"}, {1, "Z"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x58
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {3, "€"}, {0, ""}, {0, ""},  // 0x60
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x68
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x70
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}   // 0x78
+};
+
+// Urdu single shift table (A.2.13)
+constexpr Gsm7Utf8 URDU_SINGLE[128] = {
+    {1, "@"}, {2, "£"}, {1, "$"}, {2, "¥"}, {2, "¿"}, {1, "\""}, {2, "¤"}, {1, "%"},  // 0x00
+    {1, "&"}, {1, "'"}, {1, "\f"}, {1, "*"}, {1, "+"}, {0, ""}, {1, "-"}, {1, "/"},  // 0x08
+    {1, "<"}, {1, "="}, {1, ">"}, {2, "¡"}, {1, "^"}, {2, "¡"}, {1, "_"}, {1, "#"},  // 0x10
+    {1, "*"}, {2, "؀"}, {2, "؁"}, {0, ""}, {2, "۰"}, {2, "۱"}, {2, "۲"}, {2, "۳"},  // 0x18
+    {2, "۴"}, {2, "۵"}, {2, "۶"}, {2, "۷"}, {2, "۸"}, {2, "۹"}, {2, "،"}, {2, "؍"},  // 0x20
+    {1, "{"}, {1, "}"}, {2, "؎"}, {2, "؏"}, {2, "ؐ"}, {2, "ؑ"}, {2, "ؒ"}, {1, "\\"},  // 0x28
+    {2, "ؓ"}, {2, "ؔ"}, {2, "؛"}, {2, "؟"}, {2, "ـ"}, {2, "ْ"}, {2, "٘"}, {2, "٫"},  // 0x30
+    {2, "٬"}, {2, "ٲ"}, {2, "ٳ"}, {2, "ۍ"}, {1, "["}, {1, "~"}, {1, "]"}, {2, "۔"},  // 0x38
+    {1, "|"}, {1, "A"}, {1, "B"}, {1, "C"}, {1, "D"}, {1, "E"}, {1, "F"}, {1, "G"},  // 0x40
+    {1, "H"}, {1, "I"}, {1, "J"}, {1, "K"}, {1, "L"}, {1, "M"}, {1, "N"}, {1, "O"},  // 0x48
+    {1, "P"}, {1, "Q"}, {1, "R"}, {1, "S"}, {1, "T"}, {1, "U"}, {1, "V"}, {1, "W"},  // 0x50
+    {1, "X"}, {1, "Y"}, {1, "Z"}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x58
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {3, "€"}, {0, ""}, {0, ""},  // 0x60
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x68
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""},  // 0x70
+    {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}, {0, ""}   // 0x78
+};
+
+const Gsm7Utf8* lockingShift(uint8_t language) {
+    switch (language) {
+        case Gsm7Language::TURKISH:    return TURKISH_LOCKING;
+        case Gsm7Language::PORTUGUESE: return PORTUGUESE_LOCKING;
+        case Gsm7Language::BENGALI:    return BENGALI_LOCKING;
+        case Gsm7Language::GUJARATI:   return GUJARATI_LOCKING;
+        case Gsm7Language::HINDI:      return HINDI_LOCKING;
+        case Gsm7Language::KANNADA:    return KANNADA_LOCKING;
+        case Gsm7Language::MALAYALAM:  return MALAYALAM_LOCKING;
+        case Gsm7Language::ORIYA:      return ORIYA_LOCKING;
+        case Gsm7Language::PUNJABI:    return PUNJABI_LOCKING;
+        case Gsm7Language::TAMIL:      return TAMIL_LOCKING;
+        case Gsm7Language::TELUGU:     return TELUGU_LOCKING;
+        case Gsm7Language::URDU:       return URDU_LOCKING;
+        default:                       return BASIC;
+    }
+}
+
+const Gsm7Utf8* singleShift(uint8_t language) {
+    switch (language) {
+        case Gsm7Language::TURKISH:    return TURKISH_SINGLE;
+        case Gsm7Language::SPANISH:    return SPANISH_SINGLE;
+        case Gsm7Language::PORTUGUESE: return PORTUGUESE_SINGLE;
+        case Gsm7Language::BENGALI:    return BENGALI_SINGLE;
+        case Gsm7Language::GUJARATI:   return GUJARATI_SINGLE;
+        case Gsm7Language::HINDI:      return HINDI_SINGLE;
+        case Gsm7Language::KANNADA:    return KANNADA_SINGLE;
+        case Gsm7Language::MALAYALAM:  return MALAYALAM_SINGLE;
+        case Gsm7Language::ORIYA:      return ORIYA_SINGLE;
+        case Gsm7Language::PUNJABI:    return PUNJABI_SINGLE;
+        case Gsm7Language::TAMIL:      return TAMIL_SINGLE;
+        case Gsm7Language::TELUGU:     return TELUGU_SINGLE;
+        case Gsm7Language::URDU:       return URDU_SINGLE;
+        default:                       return EXTENDED;
+    }
+}
+
+} // namespace Gsm7Tables
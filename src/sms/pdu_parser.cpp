@@ -1,9 +1,40 @@
 #include "sms/pdu_parser.h"
+#include "sms/hex_decoder.h"
 #include "sms/text_decoder.h"
 #include "config.h"
 
 bool PduParser::parse(const String& pduHex, SmsMessage& out) {
-    if (pduHex.length() < 20) {
+    return parse(pduHex.c_str(), pduHex.length(), out);
+}
+
+bool PduParser::parse(const char* hex, size_t len, SmsMessage& out) {
+    PduScratch scratch;
+    return parse(hex, len, out, scratch);
+}
+
+bool PduParser::parse(const char* hex, size_t len, SmsMessage& out, PduScratch& scratch) {
+    // Tolerate surrounding whitespace without copying
+    while (len > 0 && isspace((unsigned char)hex[0])) {
+        hex++;
+        len--;
+    }
+    while (len > 0 && isspace((unsigned char)hex[len - 1])) {
+        len--;
+    }
+
+    // Convert the whole PDU to binary once, fields are then plain byte reads
+    int badPos = 0;
+    int pduLen = HexDecoder::decode(hex, len, scratch.pdu, sizeof(scratch.pdu), &badPos);
+    if (pduLen < 0) {
+        DEBUG_PRINTF("ERROR: Invalid PDU hex at offset %d\n", badPos);
+        return false;
+    }
+
+    return parseBytes(scratch.pdu, pduLen, out);
+}
+
+bool PduParser::parseBytes(const uint8_t* pdu, int len, SmsMessage& out) {
+    if (len < 10) {
         DEBUG_PRINTLN("ERROR: PDU too short");
         return false;
     }
@@ -11,13 +42,17 @@ bool PduParser::parse(const String& pduHex, SmsMessage& out) {
     int pos = 0;
 
     // 1. SMSC length (Service Center Address)
-    uint8_t smscLen = hexToByte(pduHex.charAt(pos), pduHex.charAt(pos + 1));
-    pos += 2;
-    pos += smscLen * 2; // Skip SMSC address
+    uint8_t smscLen = pdu[pos++];
+    pos += smscLen; // Skip SMSC address
+
+    // PDU type + sender length + type of address
+    if (pos + 3 > len) {
+        DEBUG_PRINTLN("ERROR: PDU truncated in header");
+        return false;
+    }
 
     // 2. PDU Type (first octet) - determines message format
-    uint8_t pduType = hexToByte(pduHex.charAt(pos), pduHex.charAt(pos + 1));
-    pos += 2;
+    uint8_t pduType = pdu[pos++];
 
     // Check UDHI (User Data Header Indicator) flag
     bool hasUdh = (pduType & PduConst::UDHI_FLAG) != 0;
@@ -25,43 +60,65 @@ bool PduParser::parse(const String& pduHex, SmsMessage& out) {
     DEBUG_PRINTF("PDU Type: 0x%02X, UDHI: %d\n", pduType, hasUdh);
 
     // 3. Sender Address Length (in digits/characters)
-    uint8_t senderLen = hexToByte(pduHex.charAt(pos), pduHex.charAt(pos + 1));
-    pos += 2;
+    uint8_t senderLen = pdu[pos++];
 
     // 4. Type of Address
-    uint8_t typeOfAddr = hexToByte(pduHex.charAt(pos), pduHex.charAt(pos + 1));
-    pos += 2;
+    uint8_t typeOfAddr = pdu[pos++];
+
+    // A longer address is malformed: its length would misplace every later field
+    if (senderLen > PduConst::MAX_ADDRESS_DIGITS) {
+        DEBUG_PRINTF("ERROR: Sender address too long (%d semi-octets)\n", senderLen);
+        return false;
+    }
+
+    // Sender + PID + DCS + timestamp + UDL must all be present
+    int addrBytes = (senderLen + 1) / 2;
+    if (pos + addrBytes + 1 + 1 + 7 + 1 > len) {
+        DEBUG_PRINTLN("ERROR: PDU truncated before user data");
+        return false;
+    }
 
     // 5. Sender Address
-    out.sender = decodeSender(pduHex, pos, senderLen, typeOfAddr);
+    out.sender = decodeSender(pdu, pos, senderLen, typeOfAddr);
+    if ((typeOfAddr & PduConst::TOA_TYPE_MASK) == PduConst::TOA_ALPHANUMERIC) {
+        out.senderClass = SenderClass::ALPHANUMERIC;
+    } else if (senderLen <= PduConst::SHORT_CODE_MAX_DIGITS) {
+        out.senderClass = SenderClass::SHORT_CODE;
+    } else {
+        out.senderClass = SenderClass::PHONE;
+    }
 
     // 6. Protocol Identifier (PID)
-    pos += 2; // Skip PID
+    pos++; // Skip PID
 
     // 7. Data Coding Scheme (DCS)
-    uint8_t dcs = hexToByte(pduHex.charAt(pos), pduHex.charAt(pos + 1));
-    pos += 2;
+    uint8_t dcs = pdu[pos++];
 
     // 8. Timestamp (7 octets in semi-octet format)
-    out.timestamp = decodeTimestamp(pduHex, pos);
+    out.timestamp = decodeTimestamp(pdu, pos);
 
     // 9. User Data Length (UDL)
-    uint8_t udl = hexToByte(pduHex.charAt(pos), pduHex.charAt(pos + 1));
-    pos += 2;
+    uint8_t udl = pdu[pos++];
+
+    // Capacity checks against the 140-octet UD limit
+    int udBytes = len - pos;
+    if (udBytes > PduConst::MAX_UD_OCTETS) {
+        DEBUG_PRINTF("ERROR: User data too long (%d octets)\n", udBytes);
+        return false;
+    }
+    bool ucs2 = (dcs & PduConst::DCS_ENCODING_MASK) == PduConst::DCS_UCS2;
+    if (udl > (ucs2 ? PduConst::MAX_UD_OCTETS : PduConst::MAX_UD_SEPTETS)) {
+        DEBUG_PRINTF("ERROR: Invalid UDL %d\n", udl);
+        return false;
+    }
 
     // 10. User Data (UD) - may contain UDH if UDHI flag is set
-    out.text = decodeUserData(pduHex, pos, dcs, udl, hasUdh, out.partInfo);
+    out.text = decodeUserData(pdu + pos, len - pos, dcs, udl, hasUdh, out.partInfo);
 
     return out.sender.length() > 0 && out.text.length() > 0;
 }
 
-uint8_t PduParser::hexToByte(char high, char low) {
-    uint8_t h = (high >= 'A') ? (high - 'A' + 10) : (high - '0');
-    uint8_t l = (low >= 'A') ? (low - 'A' + 10) : (low - '0');
-    return (h << 4) | l;
-}
-
-String PduParser::decodeSender(const String& pdu, int& pos, int senderLen, uint8_t typeOfAddr) {
+String PduParser::decodeSender(const uint8_t* pdu, int& pos, int senderLen, uint8_t typeOfAddr) {
     // Type of Address format: bit 7 = extension, bits 6-4 = type, bits 3-0 = numbering plan
     // Type: 000 = unknown, 001 = international, 010 = national, 101 = alphanumeric
 
@@ -77,63 +134,58 @@ String PduParser::decodeSender(const String& pdu, int& pos, int senderLen, uint8
     }
 }
 
-String PduParser::decodePhoneNumber(const String& pdu, int& pos, int digitCount) {
+String PduParser::decodePhoneNumber(const uint8_t* pdu, int& pos, int digitCount) {
     // Phone number in semi-octet format (nibbles swapped)
     // Example: "79123456789" -> 97 21 43 65 87 F9
-    String phone = "";
+    char phone[24];
+    int len = 0;
     int byteCount = (digitCount + 1) / 2;
 
-    for (int i = 0; i < byteCount; i++) {
-        uint8_t byte = hexToByte(pdu.charAt(pos), pdu.charAt(pos + 1));
-        pos += 2;
-
-        char low = (byte & PduConst::NIBBLE_LOW) + '0';
-        char high = (byte >> 4) == PduConst::NIBBLE_LOW ? '\0' : ((byte >> 4) + '0');
+    phone[len++] = '+'; // Add + prefix for international format
+    for (int i = 0; i < byteCount && len < (int)sizeof(phone) - 2; i++) {
+        uint8_t byte = pdu[pos + i];
 
-        phone += low;
-        if (high != '\0') {
-            phone += high;
+        phone[len++] = (byte & PduConst::NIBBLE_LOW) + '0';
+        if ((byte >> 4) != PduConst::NIBBLE_LOW) {
+            phone[len++] = (byte >> 4) + '0';
         }
     }
+    phone[len] = '\0';
+    pos += byteCount;  // The whole field, even if the digits didn't all fit
 
-    return '+' + phone; // Add + prefix for international format
+    return String(phone);
 }
 
-String PduParser::decodeAlphanumeric(const String& pdu, int& pos, int senderLen) {
+String PduParser::decodeAlphanumeric(const uint8_t* pdu, int& pos, int senderLen) {
     // Alphanumeric sender is encoded in GSM 7-bit
     // senderLen = number of useful semi-octets (nibbles) in address field
     int byteCount = (senderLen + 1) / 2;  // Semi-octets to bytes (round up)
     int charCount = (senderLen * 4) / 7;  // Semi-octets to GSM 7-bit characters
 
-    // Use static buffer to save stack space on MCU
-    static uint8_t buffer[50];
-    for (int i = 0; i < byteCount && i < 50; i++) {
-        buffer[i] = hexToByte(pdu.charAt(pos), pdu.charAt(pos + 1));
-        pos += 2;
-    }
-
-    return TextDecoder::decodeGsm7bit(buffer, charCount, 0);
+    // Septets are unpacked straight from the PDU buffer
+    String name = TextDecoder::decodeGsm7bit(pdu + pos, charCount, 0);
+    pos += byteCount;
+    return name;
 }
 
-String PduParser::decodeTimestamp(const String& pdu, int& pos) {
+String PduParser::decodeTimestamp(const uint8_t* pdu, int& pos) {
     // Timestamp: 7 octets in semi-octet format
     // Format: YY MM DD HH MM SS TZ
     // Each octet has nibbles swapped (e.g., 62 = 26)
 
-    char buffer[30];
+    char buffer[32];
     uint8_t values[7];
 
     for (int i = 0; i < 7; i++) {
-        uint8_t byte = hexToByte(pdu.charAt(pos), pdu.charAt(pos + 1));
-        pos += 2;
+        uint8_t byte = pdu[pos++];
         values[i] = ((byte & PduConst::NIBBLE_LOW) * 10) + (byte >> 4);
     }
 
     // Parse timezone (quarter-hours from GMT)
-    // Bit 7 of TZ byte = sign (0=positive, 1=negative)
-    uint8_t tzByte = hexToByte(pdu.charAt(pos - 2), pdu.charAt(pos - 1));
-    bool tzNegative = (tzByte & 0x08) != 0; // Bit 3 of high nibble
-    int tzQuarters = values[6];
+    // Bit 3 of the TZ octet = sign (0=positive, 1=negative)
+    uint8_t tzByte = pdu[pos - 1];
+    bool tzNegative = (tzByte & PduConst::TZ_SIGN) != 0;
+    int tzQuarters = ((tzByte & (PduConst::TZ_SIGN - 1)) * 10) + (tzByte >> 4);
     int tzHours = tzQuarters / 4;
     int tzMinutes = (tzQuarters % 4) * 15;
 
@@ -145,99 +197,117 @@ String PduParser::decodeTimestamp(const String& pdu, int& pos) {
     return String(buffer);
 }
 
-bool PduParser::parseUdh(const uint8_t* data, int udhLen, SmsPartInfo& partInfo) {
+bool PduParser::parseUdh(const uint8_t* data, int udhLen, SmsPartInfo& partInfo, Gsm7Shift& shift) {
     // UDH (User Data Header) format:
     // - IEI (1 byte): Information Element Identifier
     // - IEDL (1 byte): IE Data Length
     // - IE Data (IEDL bytes)
+    // All elements are walked: concatenation and language shifts can appear together
 
+    bool found = false;
     int pos = 0;
-    while (pos < udhLen) {
+    while (pos + 2 <= udhLen) {
         uint8_t iei = data[pos++];
         uint8_t iedl = data[pos++];
 
+        if (pos + iedl > udhLen) {
+            DEBUG_PRINTLN("WARNING: UDH element overruns header");
+            return found;
+        }
+
         if (iei == PduConst::IEI_CONCAT_8BIT) {
             // 8-bit concatenated SMS reference
             if (iedl >= 3) {
                 partInfo.isMultiPart = true;
                 partInfo.refNumber = data[pos];
+                partInfo.ref16Bit = false;
                 partInfo.totalParts = data[pos + 1];
                 partInfo.partNumber = data[pos + 2];
                 DEBUG_PRINTF("UDH: Multi-part SMS (8-bit ref=%d, part %d/%d)\n",
                     partInfo.refNumber, partInfo.partNumber, partInfo.totalParts);
-                return true;
+                found = true;
             }
         } else if (iei == PduConst::IEI_CONCAT_16BIT) {
             // 16-bit concatenated SMS reference
             if (iedl >= 4) {
                 partInfo.isMultiPart = true;
                 partInfo.refNumber = (data[pos] << 8) | data[pos + 1];
+                partInfo.ref16Bit = true;
                 partInfo.totalParts = data[pos + 2];
                 partInfo.partNumber = data[pos + 3];
                 DEBUG_PRINTF("UDH: Multi-part SMS (16-bit ref=%d, part %d/%d)\n",
                     partInfo.refNumber, partInfo.partNumber, partInfo.totalParts);
-                return true;
+                found = true;
+            }
+        } else if (iei == PduConst::IEI_SINGLE_SHIFT) {
+            // National language single shift table (replaces extension table)
+            if (iedl >= 1) {
+                shift.single = data[pos];
+                DEBUG_PRINTF("UDH: Single shift language %d\n", shift.single);
+                found = true;
+            }
+        } else if (iei == PduConst::IEI_LOCKING_SHIFT) {
+            // National language locking shift table (replaces default alphabet)
+            if (iedl >= 1) {
+                shift.locking = data[pos];
+                DEBUG_PRINTF("UDH: Locking shift language %d\n", shift.locking);
+                found = true;
             }
         }
 
-        pos += iedl; // Skip this IE
+        pos += iedl; // Next IE
     }
 
-    return false;
+    return found;
 }
 
-String PduParser::decodeUserData(const String& pdu, int& pos, uint8_t dcs, int udl,
+String PduParser::decodeUserData(const uint8_t* ud, int udBytes, uint8_t dcs, int udl,
                                    bool hasUdh, SmsPartInfo& partInfo) {
-    // Use static buffer to save stack space on MCU
-    static uint8_t buffer[200];
-
     uint8_t encoding = dcs & PduConst::DCS_ENCODING_MASK;
     int udhLen = 0;
+    Gsm7Shift shift;
 
-    // If UDH is present, extract it first
-    if (hasUdh) {
+    // If UDH is present, parse it in place
+    if (hasUdh && udBytes > 0) {
         // First byte of UD is UDHL (UDH Length)
-        uint8_t udhl = hexToByte(pdu.charAt(pos), pdu.charAt(pos + 1));
-        pos += 2;
+        uint8_t udhl = ud[0];
+        udhLen = udhl + 1; // +1 for UDHL byte itself
 
-        // Read UDH
-        for (int i = 0; i < udhl && i < 200; i++) {
-            buffer[i] = hexToByte(pdu.charAt(pos), pdu.charAt(pos + 1));
-            pos += 2;
+        if (udhLen > udBytes) {
+            DEBUG_PRINTLN("ERROR: UDH longer than user data");
+            return "";
         }
 
-        parseUdh(buffer, udhl, partInfo);
-
-        udhLen = udhl + 1; // +1 for UDHL byte itself
+        parseUdh(ud + 1, udhl, partInfo, shift);
     }
 
     if (encoding == PduConst::DCS_UCS2) {
         // UCS-2 (16-bit Unicode)
-        int textByteCount = udl - udhLen;
-
-        for (int i = 0; i < textByteCount && i < 200; i++) {
-            buffer[i] = hexToByte(pdu.charAt(pos), pdu.charAt(pos + 1));
-            pos += 2;
+        // UDL is in octets and includes the UDH
+        int textByteCount = min(udl, udBytes) - udhLen;
+        if (textByteCount < 0) {
+            textByteCount = 0;
         }
 
-        return TextDecoder::decodeUcs2(buffer, textByteCount);
+        return TextDecoder::decodeUcs2(ud + udhLen, textByteCount);
     } else {
         // GSM 7-bit (default)
-        // UDL is in septets (characters), not bytes
+        // UDL is in septets (characters), not bytes, and includes the UDH
         int totalSeptets = udl;
         int textSeptets = totalSeptets - (hasUdh ? ((udhLen * 8 + 6) / 7) : 0);
-        int byteCount = (totalSeptets * 7 + 7) / 8;
-
-        // Read all bytes
-        for (int i = 0; i < byteCount && i < 200; i++) {
-            buffer[i] = hexToByte(pdu.charAt(pos), pdu.charAt(pos + 1));
-            pos += 2;
-        }
 
-        // Calculate padding bits after UDH
+        // Text starts on the first septet boundary after the UDH
         int paddingBits = hasUdh ? (7 - ((udhLen * 8) % 7)) % 7 : 0;
-        int textStartBit = hasUdh ? (udhLen * 8 + paddingBits) : 0;
 
-        return TextDecoder::decodeGsm7bit(buffer + (textStartBit / 8), textSeptets, textStartBit % 8);
+        // Never unpack past the octets actually received
+        int availableSeptets = ((udBytes - udhLen) * 8 - paddingBits) / 7;
+        if (textSeptets > availableSeptets) {
+            textSeptets = availableSeptets;
+        }
+        if (textSeptets < 0) {
+            textSeptets = 0;
+        }
+
+        return TextDecoder::decodeGsm7bit(ud + udhLen, textSeptets, paddingBits, shift);
     }
 }
@@ -0,0 +1,125 @@
+#include "sms/pdu_stream_parser.h"
+#include "sms/hex_decoder.h"
+#include "config.h"
+
+PduStreamParser::PduStreamParser() {
+    reset();
+}
+
+void PduStreamParser::reset(int expectedLen) {
+    octetCount = 0;
+    smscOctets = 0;
+    expectedTpduLen = expectedLen;
+    remaining = 0;
+    field = Field::SMSC_LEN;
+    highNibble = 0;
+    haveHigh = false;
+    dcs = 0;
+}
+
+PduStreamParser::Result PduStreamParser::feed(char c) {
+    if (c == '\r' || c == '\n') {
+        if (octetCount == 0 && !haveHigh && field != Field::INVALID) {
+            return Result::NEED_MORE; // Blank line before the PDU
+        }
+
+        if (field != Field::DONE || haveHigh) {
+            DEBUG_PRINTF("ERROR: PDU line ended early (%d octets)\n", octetCount);
+            return Result::ERROR;
+        }
+        if (expectedTpduLen > 0 && octetCount - smscOctets != expectedTpduLen) {
+            DEBUG_PRINTF("ERROR: PDU length %d, header says %d\n",
+                octetCount - smscOctets, expectedTpduLen);
+            return Result::ERROR;
+        }
+        return Result::COMPLETE;
+    }
+
+    if (field == Field::INVALID) {
+        return Result::NEED_MORE; // Swallow the rest of a bad line
+    }
+
+    uint8_t nibble = HexDecoder::nibble(c);
+    if (nibble & HexConst::INVALID_FLAG) {
+        DEBUG_PRINTF("ERROR: Invalid PDU hex character 0x%02X\n", (uint8_t)c);
+        field = Field::INVALID;
+        return Result::NEED_MORE;
+    }
+
+    if (!haveHigh) {
+        highNibble = nibble;
+        haveHigh = true;
+        return Result::NEED_MORE;
+    }
+    haveHigh = false;
+
+    if (field == Field::DONE || octetCount >= PduConst::MAX_PDU_OCTETS) {
+        DEBUG_PRINTLN("ERROR: PDU longer than its header fields");
+        field = Field::INVALID;
+        return Result::NEED_MORE;
+    }
+
+    uint8_t octet = (highNibble << 4) | nibble;
+    scratch.pdu[octetCount++] = octet;
+    onOctet(octet);
+    return Result::NEED_MORE;
+}
+
+void PduStreamParser::onOctet(uint8_t octet) {
+    switch (field) {
+        case Field::SMSC_LEN:
+            remaining = octet;
+            smscOctets = 1 + octet;
+            field = remaining ? Field::SMSC : Field::FIRST_OCTET;
+            break;
+        case Field::SMSC:
+            if (--remaining == 0) field = Field::FIRST_OCTET;
+            break;
+        case Field::FIRST_OCTET:
+            field = Field::OA_LEN;
+            break;
+        case Field::OA_LEN:
+            remaining = (octet + 1) / 2; // Semi-octets to octets
+            field = Field::OA_TOA;
+            break;
+        case Field::OA_TOA:
+            field = remaining ? Field::OA : Field::PID;
+            break;
+        case Field::OA:
+            if (--remaining == 0) field = Field::PID;
+            break;
+        case Field::PID:
+            field = Field::DCS;
+            break;
+        case Field::DCS:
+            dcs = octet;
+            remaining = 7;
+            field = Field::SCTS;
+            break;
+        case Field::SCTS:
+            if (--remaining == 0) field = Field::UDL;
+            break;
+        case Field::UDL: {
+            // UDL counts septets for GSM 7-bit, octets otherwise
+            bool septets = (dcs & PduConst::DCS_ENCODING_MASK) == PduConst::DCS_GSM7;
+            remaining = septets ? (octet * 7 + 7) / 8 : octet;
+            if (remaining > PduConst::MAX_UD_OCTETS) {
+                DEBUG_PRINTF("ERROR: Invalid UDL %d\n", octet);
+                field = Field::INVALID;
+            } else {
+                field = remaining ? Field::UD : Field::DONE;
+            }
+            break;
+        }
+        case Field::UD:
+            if (--remaining == 0) field = Field::DONE;
+            break;
+        case Field::DONE:
+        case Field::INVALID:
+            break;
+    }
+}
+
+bool PduStreamParser::finish(SmsMessage& out) const {
+    return PduParser::parseBytes(scratch.pdu, octetCount, out);
+}
@@ -0,0 +1,163 @@
+#include "sms/sms_classifier.h"
+
+static_assert(SMS_OTP_MIN_DIGITS > 0 && SMS_OTP_MIN_DIGITS <= SMS_OTP_MAX_DIGITS, "SMS_OTP digit range is empty");
+
+SmsLane SmsClassifier::classify(const SmsMessage& sms) {
+#if SMS_PRIORITY_ENABLED
+    if (isPrioritySender(sms)) {
+        return SmsLane::PRIORITY;
+    }
+#if SMS_PRIORITY_OTP
+    if (looksLikeOtp(sms.text)) {
+        return SmsLane::PRIORITY;
+    }
+#endif
+#endif
+    return SmsLane::BULK;
+}
+
+bool SmsClassifier::isPrioritySender(const SmsMessage& sms) {
+#if SMS_PRIORITY_SHORT_CODES
+    if (sms.senderClass == SenderClass::SHORT_CODE) {
+        return true;
+    }
+#endif
+    return senderListed(sms.sender.c_str(), SMS_PRIORITY_SENDERS);
+}
+
+bool SmsClassifier::looksLikeOtp(const String& text) {
+    return hasKeyword(text.c_str()) && hasCode(text.c_str());
+}
+
+bool SmsClassifier::senderListed(const char* sender, const char* list) {
+    // Comma-separated, whole sender, ASCII case-insensitive
+    size_t senderLength = strlen(sender);
+    const char* entry = list;
+    while (*entry != '\0') {
+        const char* end = strchr(entry, ',');
+        size_t length = end != nullptr ? (size_t)(end - entry) : strlen(entry);
+        if (length > 0 && length == senderLength && strncasecmp(entry, sender, length) == 0) {
+            return true;
+        }
+        if (end == nullptr) {
+            break;
+        }
+        entry = end + 1;
+    }
+    return false;
+}
+
+bool SmsClassifier::hasKeyword(const char* text) {
+    for (const char* p = text; *p != '\0'; p++) {
+        // Keywords start a word ("pin" matches "PIN:" but not "shopping")
+        if (p != text && isWordChar(p[-1])) {
+            continue;
+        }
+        // ...and end one ("code" but not "Codec")
+        for (const char* keyword : OtpConst::KEYWORDS) {
+            size_t length = matchFolded(p, keyword);
+            if (length > 0 && !isWordChar(p[length])) {
+                return true;
+            }
+        }
+        for (const char* prefix : OtpConst::KEYWORD_PREFIXES) {
+            if (matchFolded(p, prefix) > 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool SmsClassifier::hasCode(const char* text) {
+    const char* p = text;
+    while (*p != '\0') {
+        if (!isdigit((unsigned char)*p) || (p != text && isWordChar(p[-1]))) {
+            p++;
+            continue;
+        }
+
+        // Digit run, allowing single spaces or dashes between groups
+        const char* run = p;
+        int digits = 0;
+        while (true) {
+            if (isdigit((unsigned char)*p)) {
+                digits++;
+                p++;
+            } else if ((*p == ' ' || *p == '-') && isdigit((unsigned char)p[1])) {
+                p++;
+            } else {
+                break;
+            }
+        }
+
+        // Standalone: a phone number or amount runs longer, a word glued on is not a code
+        if (!isWordChar(*p) && digits >= SMS_OTP_MIN_DIGITS && digits <= SMS_OTP_MAX_DIGITS &&
+            !isYear(run, p - run) && !followsReferenceWord(text, run)) {
+            return true;
+        }
+        while (*p != '\0' && isWordChar(*p)) {
+            p++;
+        }
+    }
+    return false;
+}
+
+bool SmsClassifier::isYear(const char* run, int length) {
+    return length == 4 && ((run[0] == '1' && run[1] == '9') || (run[0] == '2' && run[1] == '0'));
+}
+
+bool SmsClassifier::followsReferenceWord(const char* text, const char* run) {
+    // Back over separators ("Order #5521", "Ref: 5521") to the previous word
+    const char* end = run;
+    while (end != text && !isWordChar(end[-1])) {
+        end--;
+    }
+    const char* start = end;
+    while (start != text && isWordChar(start[-1])) {
+        start--;
+    }
+    if (start == end) {
+        return false;
+    }
+
+    for (const char* word : OtpConst::REFERENCE_WORDS) {
+        if (matchFolded(start, word) == (size_t)(end - start)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t SmsClassifier::matchFolded(const char* p, const char* word) {
+    const uint8_t* text = (const uint8_t*)p;
+    const uint8_t* w = (const uint8_t*)word;
+    size_t i = 0;
+    while (w[i] != '\0') {
+        uint8_t c = text[i];
+        if (c == 0xD0 && text[i + 1] != '\0') {
+            // Cyrillic capitals fold to their lowercase pair
+            uint8_t lead = 0xD0;
+            uint8_t next = text[i + 1];
+            if (next >= 0x90 && next <= 0x9F) {         // А-П → а-п (D0 B0-BF)
+                next += 0x20;
+            } else if (next >= 0xA0 && next <= 0xAF) {  // Р-Я → р-я (D1 80-8F)
+                lead = 0xD1;
+                next -= 0x20;
+            } else if (next == 0x81) {                  // Ё → ё (D1 91)
+                lead = 0xD1;
+                next = 0x91;
+            }
+            if (w[i] != lead || w[i + 1] != next) {
+                return 0;
+            }
+            i += 2;
+            continue;
+        }
+        if (c == '\0' || tolower(c) != w[i]) {
+            return 0;
+        }
+        i++;
+    }
+    return i;
+}
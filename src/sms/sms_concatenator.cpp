@@ -4,6 +4,44 @@
 // Static storage for result (avoids heap allocation on each call)
 SmsMessage SmsConcatenator::resultBuffer;
 
+bool SmsConcatenator::init(SmsJournal* journal) {
+    if (arena != nullptr) {
+        return true;
+    }
+
+    size_t slotBytes = (size_t)SMS_CONCAT_MAX_PARTS * ConcatConst::PART_TEXT_CAPACITY;
+    size_t arenaBytes = slotBytes * SMS_CONCAT_SLOTS;
+
+#ifdef BOARD_HAS_PSRAM
+    if (psramFound()) {
+        arena = (char*)ps_malloc(arenaBytes);
+    }
+#endif
+    if (arena == nullptr) {
+        arena = (char*)malloc(arenaBytes);
+    }
+    if (arena == nullptr) {
+        DEBUG_PRINTF("ERROR: Failed to allocate %u bytes for multi-part buffer\n", (unsigned)arenaBytes);
+        return false;
+    }
+
+    for (int i = 0; i < SMS_CONCAT_SLOTS; i++) {
+        slots[i] = SmsReassemblySlot();
+        slots[i].partText = arena + i * slotBytes;
+        heapIndex[i] = -1;
+    }
+    heapSize = 0;
+
+    DEBUG_PRINTF("Multi-part buffer: %d slots x %d parts (%u bytes)\n",
+        SMS_CONCAT_SLOTS, SMS_CONCAT_MAX_PARTS, (unsigned)arenaBytes);
+
+    this->journal = journal;
+    if (journal != nullptr) {
+        restoreFromJournal();
+    }
+    return true;
+}
+
 SmsMessage* SmsConcatenator::addPart(const SmsMessage& sms) {
     if (!sms.partInfo.isMultiPart) {
         // Single-part SMS, return as-is
@@ -11,63 +49,613 @@ SmsMessage* SmsConcatenator::addPart(const SmsMessage& sms) {
         return &resultBuffer;
     }
 
-    uint16_t ref = sms.partInfo.refNumber;
+    const SmsPartInfo& info = sms.partInfo;
+    if (arena == nullptr || info.totalParts == 0 || info.totalParts > SMS_CONCAT_MAX_PARTS ||
+        info.partNumber == 0 || info.partNumber > info.totalParts) {
+        // Can't be reassembled here: forward the part on its own rather than lose it
+        DEBUG_PRINTF("⚠ Part %d/%d (ref: %d) can't be buffered, forwarding as-is\n",
+            info.partNumber, info.totalParts, info.refNumber);
+        resultBuffer = sms;
+        return &resultBuffer;
+    }
+
+    uint16_t ref = info.refNumber;
+    uint32_t hash = keyHash(sms);
+
+    // Initialize slot if this is the first part
+    int slot = findSlot(hash, sms);
+    if (slot >= 0 && slot == pendingExpired) {
+        // Its partial is already on the way to the server: follow it up
+        DEBUG_PRINTF("↺ Part %d/%d (ref: %d) arrived during the partial send, sending as amendment\n",
+            info.partNumber, info.totalParts, ref);
+        resultBuffer = sms;
+        resultBuffer.delivery = SmsDelivery::AMENDMENT;
+        return &resultBuffer;
+    }
+    if (slot < 0) {
+        int late = findFlushed(hash, sms);
+        if (late >= 0) {
+            int idx = info.partNumber - 1;
+            SmsFlushedKey& entry = flushed[late];
+            uint32_t bit = 1UL << (idx % 32);
+            if (!(entry.missingMask[idx / 32] & bit)) {
+                // Redelivered by the SMSC after the message went out: don't
+                // let it open a fresh slot and go out again as a PARTIAL
+                DEBUG_PRINTF("↺ Part %d/%d (ref: %d) already delivered, dropping duplicate\n",
+                    info.partNumber, info.totalParts, ref);
+                return nullptr;
+            }
+
+            // The message already went out as PARTIAL: send this part on its own
+            entry.missingMask[idx / 32] &= ~bit;
+            DEBUG_PRINTF("↺ Late part %d/%d (ref: %d), sending as amendment\n",
+                info.partNumber, info.totalParts, ref);
+            resultBuffer = sms;
+            resultBuffer.delivery = SmsDelivery::AMENDMENT;
+            return &resultBuffer;
+        }
+        slot = allocateSlot(hash, sms);
+        if (slot < 0) {
+            // Callers check hasRoomFor() first; never drop a buffered message
+            // for this one, forward the part on its own instead
+            DEBUG_PRINTF("⚠ Pool full: part %d/%d (ref: %d) forwarded as-is\n",
+                info.partNumber, info.totalParts, ref);
+            expediteOldest();
+            resultBuffer = sms;
+            return &resultBuffer;
+        }
+    }
+    storePart(slot, sms);
 
-    // Initialize buffer if this is the first part
-    if (partBuffers.find(ref) == partBuffers.end()) {
-        partBuffers[ref].sender = sms.sender;
-        partBuffers[ref].timestamp = sms.timestamp;
-        partBuffers[ref].totalParts = sms.partInfo.totalParts;
-        partBuffers[ref].parts.resize(sms.partInfo.totalParts);
-        partBuffers[ref].firstPartTime = millis();
+    // Check if all parts received
+    SmsReassemblySlot& buffer = slots[slot];
+    if (!isComplete(slot)) {
+        // Only buffered parts go to the journal: the completing part stays
+        // on the SIM until the whole message is delivered
+        if (journal != nullptr && !journal->appendPart(sms)) {
+            journalOk = false;
+        }
+        return nullptr;  // More parts needed
     }
 
-    SmsPartBuffer& buffer = partBuffers[ref];
+    buildResult(buffer);
+
+    DEBUG_PRINTF("✓ Concatenated %d-part SMS (ref: %d)\n", buffer.totalParts, ref);
 
-    // Store this part (1-based indexing)
+    // The slot is kept until markDelivered(): if the send fails, the
+    // completing part is read from the SIM again and the message rebuilt
+    return &resultBuffer;
+}
+
+void SmsConcatenator::storePart(int slot, const SmsMessage& sms) {
+    SmsReassemblySlot& buffer = slots[slot];
+    buffer.lastIndex = sms.index;
+
+    // Store this part (1-based numbering, bit n-1)
     int idx = sms.partInfo.partNumber - 1;
-    if (idx >= 0 && idx < buffer.totalParts) {
-        buffer.parts[idx] = sms.text;
+    uint32_t bit = 1UL << (idx % 32);
+    if (!(buffer.receivedMask[idx / 32] & bit)) {
+        buffer.receivedMask[idx / 32] |= bit;
+        buffer.receivedCount++;
     }
 
-    // Check if all parts received
-    bool allReceived = true;
+    size_t len = sms.text.length();
+    if (len > (size_t)ConcatConst::PART_TEXT_CAPACITY) {
+        DEBUG_PRINTF("⚠ Part %d text truncated (%u bytes)\n", sms.partInfo.partNumber, (unsigned)len);
+        len = ConcatConst::PART_TEXT_CAPACITY;
+    }
+    memcpy(buffer.partText + idx * ConcatConst::PART_TEXT_CAPACITY, sms.text.c_str(), len);
+    buffer.partLength[idx] = len;
+}
+
+void SmsConcatenator::markDelivered(const SmsMessage& sms) {
+    // Reassembled messages carry partNumber 0; parsed parts are 1-based
+    if (sms.delivery != SmsDelivery::COMPLETE || sms.partInfo.partNumber != 0) {
+        return;
+    }
+    int slot = findSlot(keyHash(sms), sms);
+    if (slot >= 0 && isComplete(slot)) {
+        journalRelease(slot);
+        releaseSlot(slot);
+    }
+}
+
+bool SmsConcatenator::flushJournal() {
+    if (journal == nullptr) {
+        return true;
+    }
+
+    bool ok = journal->flush() && journalOk;
+    journalOk = true;
+
+    if (ok && !orphansUntracked && journal->size() > SMS_JOURNAL_COMPACT_BYTES) {
+        compactJournal();
+    }
+    return ok;
+}
+
+void SmsConcatenator::buildResult(const SmsReassemblySlot& buffer) {
+    static const size_t GAP_LENGTH = strlen(SMS_CONCAT_GAP_MARKER);
+
+    // Concatenate all parts into one exactly-sized allocation
+    size_t total = 0;
     for (int i = 0; i < buffer.totalParts; i++) {
-        if (buffer.parts[i].length() == 0) {
-            allReceived = false;
-            break;
-        }
+        bool received = (buffer.receivedMask[i / 32] >> (i % 32)) & 1;
+        total += received ? buffer.partLength[i] : GAP_LENGTH;
     }
 
-    if (allReceived) {
-        // Concatenate all parts
-        resultBuffer.index = sms.index;  // Use last part's index
-        resultBuffer.sender = buffer.sender;
-        resultBuffer.timestamp = buffer.timestamp;
-        resultBuffer.text = "";
-        for (int i = 0; i < buffer.totalParts; i++) {
-            resultBuffer.text += buffer.parts[i];
+    resultBuffer.index = buffer.lastIndex;  // Use last part's index
+    resultBuffer.sender = buffer.sender;
+    resultBuffer.senderClass = buffer.senderClass;
+    resultBuffer.timestamp = buffer.timestamp;
+    resultBuffer.text = "";
+    resultBuffer.text.reserve(total);
+    memset(resultBuffer.partsMissing, 0, sizeof(resultBuffer.partsMissing));
+    for (int i = 0; i < buffer.totalParts; i++) {
+        if ((buffer.receivedMask[i / 32] >> (i % 32)) & 1) {
+            resultBuffer.text.concat(buffer.partText + i * ConcatConst::PART_TEXT_CAPACITY, buffer.partLength[i]);
+        } else {
+            resultBuffer.text.concat(SMS_CONCAT_GAP_MARKER, GAP_LENGTH);
+            resultBuffer.partsMissing[i / 32] |= 1UL << (i % 32);
         }
+    }
+
+    // Reassembled: partNumber 0, key fields kept for markDelivered()
+    resultBuffer.partInfo.refNumber = buffer.refNumber;
+    resultBuffer.partInfo.ref16Bit = buffer.ref16Bit;
+    resultBuffer.partInfo.totalParts = buffer.totalParts;
+    resultBuffer.partInfo.partNumber = 0;
+
+    if (buffer.receivedCount == buffer.totalParts) {
         resultBuffer.partInfo.isMultiPart = false;  // Mark as complete
+        resultBuffer.delivery = SmsDelivery::COMPLETE;
+        resultBuffer.partsReceived = 0;
+        return;
+    }
+
+    resultBuffer.partInfo.isMultiPart = true;
+    resultBuffer.delivery = SmsDelivery::PARTIAL;
+    resultBuffer.partsReceived = buffer.receivedCount;
+}
 
-        // Remove from buffer
-        partBuffers.erase(ref);
+SmsMessage* SmsConcatenator::nextExpired() {
+    unsigned long now = millis();
+    while (heapSize > 0) {
+        int slot = deadlineHeap[0];
+        if ((long)(now - slots[slot].deadline) < 0) {
+            return nullptr;  // Earliest deadline not reached yet
+        }
 
-        DEBUG_PRINTF("✓ Concatenated %d-part SMS (ref: %d)\n", buffer.totalParts, ref);
+        const SmsReassemblySlot& buffer = slots[slot];
+#if SMS_CONCAT_TIMEOUT_POLICY == SMS_CONCAT_POLICY_DROP
+        if (!isComplete(slot)) {
+            DEBUG_PRINTF("⚠ Timeout: Dropping incomplete multi-part SMS (ref: %d, %d/%d parts)\n",
+                buffer.refNumber, buffer.receivedCount, buffer.totalParts);
+            journalRelease(slot);
+            releaseSlot(slot);
+            continue;
+        }
+#endif
+        // Incomplete (FORWARD policy), or complete but not yet delivered
+        DEBUG_PRINTF("⚠ Timeout: Forwarding multi-part SMS (ref: %d, %d/%d parts)\n",
+            buffer.refNumber, buffer.receivedCount, buffer.totalParts);
+        buildResult(buffer);
+        pendingExpired = slot;
         return &resultBuffer;
     }
+    return nullptr;
+}
 
-    return nullptr;  // More parts needed
+void SmsConcatenator::completeExpired(bool delivered) {
+    if (pendingExpired < 0) {
+        return;
+    }
+    int slot = pendingExpired;
+    pendingExpired = -1;
+
+    if (delivered) {
+        // A complete message too: its parts carry no duplicate-filter
+        // fingerprints on this path, only the key catches a redelivery
+        rememberFlushed(slots[slot]);
+        journalRelease(slot);
+        releaseSlot(slot);
+        return;
+    }
+
+    // Keep the parts and try again later
+    heapRemove(slot);
+    slots[slot].deadline = millis() + SMS_CONCAT_RETRY_INTERVAL;
+    heapPush(slot);
 }
 
-void SmsConcatenator::cleanup() {
+void SmsConcatenator::rememberFlushed(const SmsReassemblySlot& buffer) {
+    SmsFlushedKey& entry = flushed[flushedNext];
+    flushedNext = (flushedNext + 1) % SMS_CONCAT_FLUSHED_KEYS;
+
+    entry.inUse = true;
+    entry.keyHash = buffer.keyHash;
+    entry.refNumber = buffer.refNumber;
+    entry.ref16Bit = buffer.ref16Bit;
+    entry.totalParts = buffer.totalParts;
+    for (int w = 0; w < ConcatConst::MASK_WORDS; w++) {
+        entry.missingMask[w] = ~buffer.receivedMask[w];
+    }
+    // Only parts 1..totalParts can still arrive
+    for (int i = buffer.totalParts; i < ConcatConst::MASK_WORDS * 32; i++) {
+        entry.missingMask[i / 32] &= ~(1UL << (i % 32));
+    }
+    memcpy(entry.sender, buffer.sender, sizeof(entry.sender));
+    entry.flushedAt = millis();
+}
+
+int SmsConcatenator::findFlushed(uint32_t hash, const SmsMessage& sms) const {
     unsigned long now = millis();
-    for (auto it = partBuffers.begin(); it != partBuffers.end(); ) {
-        if (now - it->second.firstPartTime > PART_TIMEOUT) {
-            DEBUG_PRINTF("⚠ Timeout: Dropping incomplete multi-part SMS (ref: %d)\n", it->first);
-            it = partBuffers.erase(it);
-        } else {
-            ++it;
+    for (int i = 0; i < SMS_CONCAT_FLUSHED_KEYS; i++) {
+        const SmsFlushedKey& entry = flushed[i];
+        if (keyMatches(entry, hash, sms) && now - entry.flushedAt < SMS_CONCAT_LATE_WINDOW) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void SmsConcatenator::restoreFromJournal() {
+    if (!journal->openReplay()) {
+        return;  // No journal yet
+    }
+
+    SmsJournalRecord type;
+    SmsMessage record;
+    int restored = 0;
+    int skipped = 0;
+    while (journal->nextRecord(type, record)) {
+        const SmsPartInfo& info = record.partInfo;
+        uint32_t hash = keyHash(record);
+        int slot = findSlot(hash, record);
+
+        if (type == SmsJournalRecord::RELEASE) {
+            int orphan = findOrphan(hash, record);
+            if (slot >= 0) {
+                releaseSlot(slot);
+            } else if (orphan >= 0) {
+                orphans[orphan].inUse = false;
+            }
+            continue;
+        }
+
+        if (info.totalParts == 0 || info.totalParts > SMS_CONCAT_MAX_PARTS ||
+            info.partNumber == 0 || info.partNumber > info.totalParts) {
+            continue;
+        }
+        if (slot < 0 && findOrphan(hash, record) < 0) {
+            slot = allocateSlot(hash, record);
+        }
+        if (slot < 0) {
+            // More messages than slots (SMS_CONCAT_SLOTS lowered): leave them in the log
+            if (findOrphan(hash, record) < 0 && !addOrphan(hash, record)) {
+                orphansUntracked = true;
+            }
+            skipped++;
+            continue;
+        }
+        storePart(slot, record);
+        restored++;
+    }
+    journal->closeReplay();
+
+    // Start from a log holding only the restored parts and the ones left
+    // over, dropping released records
+    if (skipped > 0) {
+        DEBUG_PRINTF("WARNING: Multi-part journal: %d parts don't fit the pool, kept in the log\n", skipped);
+    }
+    if (orphansUntracked) {
+        DEBUG_PRINTLN("WARNING: Multi-part journal: too many messages left over, compaction off");
+    } else {
+        compactJournal();
+    }
+
+    int messages = 0;
+    for (int i = 0; i < SMS_CONCAT_SLOTS; i++) {
+        messages += slots[i].inUse ? 1 : 0;
+    }
+    DEBUG_PRINTF("Multi-part journal: restored %d parts of %d messages\n", restored, messages);
+}
+
+void SmsConcatenator::journalRelease(int slot) {
+    if (journal == nullptr) {
+        return;
+    }
+    const SmsReassemblySlot& buffer = slots[slot];
+    SmsMessage key;
+    key.sender = buffer.sender;
+    key.partInfo.refNumber = buffer.refNumber;
+    key.partInfo.ref16Bit = buffer.ref16Bit;
+    key.partInfo.totalParts = buffer.totalParts;
+    journal->appendRelease(key);
+}
+
+void SmsConcatenator::compactJournal() {
+    if (!journal->beginRewrite()) {
+        return;
+    }
+    for (int slot = 0; slot < SMS_CONCAT_SLOTS; slot++) {
+        if (!slots[slot].inUse) {
+            continue;
+        }
+        for (int i = 0; i < slots[slot].totalParts; i++) {
+            if ((slots[slot].receivedMask[i / 32] >> (i % 32)) & 1) {
+                journal->appendPart(slotPart(slot, i));
+            }
+        }
+    }
+
+    // Parts restore had no slot for, copied from the old log as they are
+    bool anyOrphans = false;
+    for (int i = 0; i < ConcatConst::ORPHAN_KEYS; i++) {
+        anyOrphans |= orphans[i].inUse;
+    }
+    if (anyOrphans && journal->openReplay()) {
+        SmsJournalRecord type;
+        SmsMessage record;
+        while (journal->nextRecord(type, record)) {
+            if (type == SmsJournalRecord::PART && findOrphan(keyHash(record), record) >= 0) {
+                journal->appendPart(record);
+            }
+        }
+        journal->closeReplay();
+    }
+
+    if (journal->commitRewrite()) {
+        DEBUG_PRINTF("Multi-part journal compacted to %u bytes\n", (unsigned)journal->size());
+    }
+}
+
+int SmsConcatenator::findOrphan(uint32_t hash, const SmsMessage& sms) const {
+    for (int i = 0; i < ConcatConst::ORPHAN_KEYS; i++) {
+        if (keyMatches(orphans[i], hash, sms)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool SmsConcatenator::addOrphan(uint32_t hash, const SmsMessage& sms) {
+    for (int i = 0; i < ConcatConst::ORPHAN_KEYS; i++) {
+        SmsOrphanKey& entry = orphans[i];
+        if (entry.inUse) {
+            continue;
+        }
+        entry.inUse = true;
+        entry.keyHash = hash;
+        entry.refNumber = sms.partInfo.refNumber;
+        entry.ref16Bit = sms.partInfo.ref16Bit;
+        entry.totalParts = sms.partInfo.totalParts;
+        strlcpy(entry.sender, sms.sender.c_str(), sizeof(entry.sender));
+        return true;
+    }
+    return false;
+}
+
+SmsMessage SmsConcatenator::slotPart(int slot, int partIndex) const {
+    const SmsReassemblySlot& buffer = slots[slot];
+    SmsMessage part;
+    part.index = buffer.lastIndex;
+    part.sender = buffer.sender;
+    part.senderClass = buffer.senderClass;
+    part.timestamp = buffer.timestamp;
+    part.partInfo.isMultiPart = true;
+    part.partInfo.refNumber = buffer.refNumber;
+    part.partInfo.ref16Bit = buffer.ref16Bit;
+    part.partInfo.totalParts = buffer.totalParts;
+    part.partInfo.partNumber = partIndex + 1;
+    part.text.concat(buffer.partText + partIndex * ConcatConst::PART_TEXT_CAPACITY, buffer.partLength[partIndex]);
+    return part;
+}
+
+bool SmsConcatenator::nextDeadline(unsigned long& deadline) const {
+    if (heapSize == 0) {
+        return false;
+    }
+    deadline = slots[deadlineHeap[0]].deadline;
+    return true;
+}
+
+unsigned long SmsConcatenator::timeoutFor(SenderClass senderClass) {
+    switch (senderClass) {
+        case SenderClass::SHORT_CODE:   return SMS_CONCAT_TIMEOUT_SHORT_CODE;
+        case SenderClass::ALPHANUMERIC: return SMS_CONCAT_TIMEOUT_ALPHANUMERIC;
+        default:                        return SMS_CONCAT_TIMEOUT_PHONE;
+    }
+}
+
+uint32_t SmsConcatenator::keyHash(const SmsMessage& sms) {
+    const SmsPartInfo& info = sms.partInfo;
+    uint32_t hash = ConcatConst::FNV_OFFSET;
+
+    // Sender as stored in the slot (truncated to the same capacity)
+    const char* sender = sms.sender.c_str();
+    for (int i = 0; i < ConcatConst::SENDER_CAPACITY - 1 && sender[i] != '\0'; i++) {
+        hash = (hash ^ (uint8_t)sender[i]) * ConcatConst::FNV_PRIME;
+    }
+
+    uint8_t tail[4] = {
+        (uint8_t)(info.refNumber >> 8), (uint8_t)info.refNumber,
+        (uint8_t)(info.ref16Bit ? 16 : 8), info.totalParts
+    };
+    for (int i = 0; i < 4; i++) {
+        hash = (hash ^ tail[i]) * ConcatConst::FNV_PRIME;
+    }
+    return hash;
+}
+
+template <typename Entry>
+bool SmsConcatenator::keyMatches(const Entry& entry, uint32_t hash, const SmsMessage& sms) {
+    const SmsPartInfo& info = sms.partInfo;
+    return entry.inUse &&
+           entry.keyHash == hash &&
+           entry.refNumber == info.refNumber &&
+           entry.ref16Bit == info.ref16Bit &&
+           entry.totalParts == info.totalParts &&
+           strncmp(entry.sender, sms.sender.c_str(), ConcatConst::SENDER_CAPACITY - 1) == 0;
+}
+
+int SmsConcatenator::findSlot(uint32_t hash, const SmsMessage& sms) const {
+    int home = homeSlot(hash);
+    for (int probe = 0; probe < SMS_CONCAT_SLOTS; probe++) {
+        int i = (home + probe) % SMS_CONCAT_SLOTS;
+        if (keyMatches(slots[i], hash, sms)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int SmsConcatenator::allocateSlot(uint32_t hash, const SmsMessage& sms) {
+    // A buffered message with the same reference but another key would have
+    // been merged with this one under a reference-only key
+    for (int i = 0; i < SMS_CONCAT_SLOTS; i++) {
+        if (slots[i].inUse && slots[i].refNumber == sms.partInfo.refNumber) {
+            collisionCount++;
+            DEBUG_PRINTF("⚠ Reference collision (ref: %d): %s vs %s, %d vs %d parts\n",
+                sms.partInfo.refNumber, slots[i].sender, sms.sender.c_str(),
+                slots[i].totalParts, sms.partInfo.totalParts);
+            break;
+        }
+    }
+
+    int home = homeSlot(hash);
+    int slot = -1;
+    for (int probe = 0; probe < SMS_CONCAT_SLOTS && slot < 0; probe++) {
+        int i = (home + probe) % SMS_CONCAT_SLOTS;
+        if (!slots[i].inUse) {
+            slot = i;
+        }
+    }
+
+    if (slot < 0) {
+        return -1;  // Pool exhausted
+    }
+
+    SmsReassemblySlot& buffer = slots[slot];
+    buffer.inUse = true;
+    buffer.keyHash = hash;
+    buffer.refNumber = sms.partInfo.refNumber;
+    buffer.ref16Bit = sms.partInfo.ref16Bit;
+    buffer.senderClass = sms.senderClass;
+    buffer.totalParts = sms.partInfo.totalParts;
+    buffer.deadline = millis() + timeoutFor(sms.senderClass);
+    strlcpy(buffer.sender, sms.sender.c_str(), sizeof(buffer.sender));
+    strlcpy(buffer.timestamp, sms.timestamp.c_str(), sizeof(buffer.timestamp));
+    heapPush(slot);
+    return slot;
+}
+
+bool SmsConcatenator::hasRoomFor(const SmsMessage& sms) const {
+    if (!sms.partInfo.isMultiPart || arena == nullptr) {
+        return true;  // Returned at once by addPart()
+    }
+    uint32_t hash = keyHash(sms);
+    if (findSlot(hash, sms) >= 0 || findFlushed(hash, sms) >= 0) {
+        return true;
+    }
+    for (int i = 0; i < SMS_CONCAT_SLOTS; i++) {
+        if (!slots[i].inUse) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SmsConcatenator::expediteOldest() {
+    if (heapSize == 0) {
+        return;
+    }
+    // The message closest to its deadline goes out now (PARTIAL under the
+    // FORWARD policy) instead of being dropped. One already in its retry
+    // backoff, or being sent, keeps its schedule
+    int slot = deadlineHeap[0];
+    unsigned long now = millis();
+    if (slot == pendingExpired || (long)(slots[slot].deadline - now) <= (long)SMS_CONCAT_RETRY_INTERVAL) {
+        return;
+    }
+    DEBUG_PRINTF("⚠ Pool full: resolving multi-part SMS (ref: %d, %d/%d parts) early\n",
+        slots[slot].refNumber, slots[slot].receivedCount, slots[slot].totalParts);
+    heapRemove(slot);
+    slots[slot].deadline = now;
+    heapPush(slot);
+}
+
+void SmsConcatenator::releaseSlot(int slot) {
+    SmsReassemblySlot& buffer = slots[slot];
+    heapRemove(slot);
+    if (pendingExpired == slot) {
+        pendingExpired = -1;
+    }
+    buffer.inUse = false;
+    buffer.receivedCount = 0;
+    memset(buffer.receivedMask, 0, sizeof(buffer.receivedMask));
+}
+
+void SmsConcatenator::heapPush(int slot) {
+    int i = heapSize++;
+    deadlineHeap[i] = slot;
+    heapIndex[slot] = i;
+    siftUp(i);
+}
+
+void SmsConcatenator::heapRemove(int slot) {
+    int i = heapIndex[slot];
+    if (i < 0) {
+        return;
+    }
+    heapIndex[slot] = -1;
+    int last = --heapSize;
+    if (i == last) {
+        return;
+    }
+    // Move the last entry into the hole and restore heap order
+    int moved = deadlineHeap[last];
+    deadlineHeap[i] = moved;
+    heapIndex[moved] = i;
+    siftUp(i);
+    siftDown(heapIndex[moved]);
+}
+
+void SmsConcatenator::heapSwap(int i, int j) {
+    int a = deadlineHeap[i];
+    int b = deadlineHeap[j];
+    deadlineHeap[i] = b;
+    deadlineHeap[j] = a;
+    heapIndex[b] = i;
+    heapIndex[a] = j;
+}
+
+void SmsConcatenator::siftUp(int i) {
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!dueBefore(deadlineHeap[i], deadlineHeap[parent])) {
+            break;
+        }
+        heapSwap(i, parent);
+        i = parent;
+    }
+}
+
+void SmsConcatenator::siftDown(int i) {
+    while (true) {
+        int smallest = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+        if (left < heapSize && dueBefore(deadlineHeap[left], deadlineHeap[smallest])) {
+            smallest = left;
+        }
+        if (right < heapSize && dueBefore(deadlineHeap[right], deadlineHeap[smallest])) {
+            smallest = right;
+        }
+        if (smallest == i) {
+            break;
         }
+        heapSwap(i, smallest);
+        i = smallest;
     }
 }
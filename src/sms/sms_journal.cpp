@@ -0,0 +1,314 @@
+#include "sms/sms_journal.h"
+#include <LittleFS.h>
+#include <rom/crc.h>
+
+static_assert(SMS_JOURNAL_BATCH_BYTES >= JournalConst::HEADER_SIZE + JournalConst::MAX_PAYLOAD,
+              "Journal batch must hold the largest record");
+
+// Static batch buffer (one journal per device)
+uint8_t SmsJournal::batch[SMS_JOURNAL_BATCH_BYTES];
+
+SmsJournal::SmsJournal() : mounted(false), rewriting(false), fileSize(0), batchLength(0) {}
+
+bool SmsJournal::init() {
+    if (!LittleFS.begin(true)) {
+        DEBUG_PRINTLN("ERROR: LittleFS mount failed");
+        return false;
+    }
+    mounted = true;
+
+    // A rewrite interrupted by a reset: the old log is still complete
+    if (LittleFS.exists(SMS_JOURNAL_REWRITE_PATH)) {
+        LittleFS.remove(SMS_JOURNAL_REWRITE_PATH);
+    }
+
+    File file = LittleFS.open(SMS_JOURNAL_PATH, "r");
+    fileSize = file ? file.size() : 0;
+    if (file) {
+        file.close();
+    }
+
+    // Replay stops at a torn or corrupt record, and flush() appends after
+    // it: cut the log there so those records aren't lost behind it
+    size_t valid = replayableLength();
+    if (valid < fileSize) {
+        DEBUG_PRINTF("WARNING: SMS journal damaged after %u of %u bytes, truncating\n",
+            (unsigned)valid, (unsigned)fileSize);
+        truncate(valid);
+    }
+
+    DEBUG_PRINTF("SMS journal: %u bytes\n", (unsigned)fileSize);
+    return true;
+}
+
+size_t SmsJournal::replayableLength() {
+    if (!openReplay()) {
+        return 0;
+    }
+    size_t valid = 0;
+    SmsJournalRecord type;
+    SmsMessage record;
+    while (nextRecord(type, record)) {
+        valid = replayFile.position();
+    }
+    closeReplay();
+    return valid;
+}
+
+bool SmsJournal::truncate(size_t length) {
+    if (length == 0) {
+        LittleFS.remove(SMS_JOURNAL_PATH);
+        fileSize = 0;
+        return true;
+    }
+
+    // No truncate in the FS API: copy the good prefix and swap it in
+    File source = LittleFS.open(SMS_JOURNAL_PATH, "r");
+    File target = LittleFS.open(SMS_JOURNAL_REWRITE_PATH, "w");
+    size_t copied = 0;
+    while (source && target && copied < length) {
+        uint8_t chunk[256];
+        size_t wanted = min(sizeof(chunk), length - copied);
+        size_t got = source.read(chunk, wanted);
+        if (got == 0 || target.write(chunk, got) != got) {
+            break;
+        }
+        copied += got;
+    }
+    if (target) {
+        target.flush();
+        target.close();
+    }
+    if (source) {
+        source.close();
+    }
+
+    if (copied != length || !LittleFS.rename(SMS_JOURNAL_REWRITE_PATH, SMS_JOURNAL_PATH)) {
+        DEBUG_PRINTLN("ERROR: Failed to truncate SMS journal");
+        LittleFS.remove(SMS_JOURNAL_REWRITE_PATH);
+        return false;
+    }
+    fileSize = length;
+    return true;
+}
+
+bool SmsJournal::appendPart(const SmsMessage& part) {
+    uint8_t payload[JournalConst::MAX_PAYLOAD];
+    int pos = 0;
+
+    const SmsPartInfo& info = part.partInfo;
+    payload[pos++] = info.refNumber >> 8;
+    payload[pos++] = info.refNumber & 0xFF;
+    payload[pos++] = info.ref16Bit ? 1 : 0;
+    payload[pos++] = info.totalParts;
+    payload[pos++] = info.partNumber;
+    payload[pos++] = (uint8_t)part.senderClass;
+    payload[pos++] = (part.index >> 8) & 0xFF;
+    payload[pos++] = part.index & 0xFF;
+    pos = putString(payload, pos, part.sender, JournalConst::MAX_FIELD);
+    pos = putString(payload, pos, part.timestamp, JournalConst::MAX_FIELD);
+    pos = putString(payload, pos, part.text, JournalConst::MAX_TEXT);
+
+    return appendRecord(SmsJournalRecord::PART, payload, pos);
+}
+
+bool SmsJournal::appendRelease(const SmsMessage& key) {
+    uint8_t payload[JournalConst::MAX_PAYLOAD];
+    int pos = 0;
+
+    const SmsPartInfo& info = key.partInfo;
+    payload[pos++] = info.refNumber >> 8;
+    payload[pos++] = info.refNumber & 0xFF;
+    payload[pos++] = info.ref16Bit ? 1 : 0;
+    payload[pos++] = info.totalParts;
+    pos = putString(payload, pos, key.sender, JournalConst::MAX_FIELD);
+
+    return appendRecord(SmsJournalRecord::RELEASE, payload, pos);
+}
+
+bool SmsJournal::appendRecord(SmsJournalRecord type, const uint8_t* payload, int length) {
+    if (!mounted) {
+        return false;
+    }
+
+    // Make room: a full batch goes to flash first
+    if (batchLength + JournalConst::HEADER_SIZE + length > sizeof(batch) && !flush()) {
+        return false;
+    }
+
+    uint32_t crc = crc32_le(0, payload, length);
+    uint8_t* out = batch + batchLength;
+    out[0] = JournalConst::MAGIC;
+    out[1] = (uint8_t)type;
+    out[2] = length >> 8;
+    out[3] = length & 0xFF;
+    out[4] = crc >> 24;
+    out[5] = (crc >> 16) & 0xFF;
+    out[6] = (crc >> 8) & 0xFF;
+    out[7] = crc & 0xFF;
+    memcpy(out + JournalConst::HEADER_SIZE, payload, length);
+    batchLength += JournalConst::HEADER_SIZE + length;
+    return true;
+}
+
+bool SmsJournal::flush() {
+    if (!mounted) {
+        return false;
+    }
+    if (batchLength == 0) {
+        return true;
+    }
+
+    File file = LittleFS.open(targetPath(), "a");
+    if (!file) {
+        DEBUG_PRINTLN("ERROR: Failed to open SMS journal");
+        return false;
+    }
+
+    size_t written = file.write(batch, batchLength);
+    file.flush();
+    file.close();
+
+    if (written != batchLength) {
+        DEBUG_PRINTF("ERROR: SMS journal write failed (%u of %u bytes)\n",
+            (unsigned)written, (unsigned)batchLength);
+        return false;
+    }
+
+    if (!rewriting) {
+        fileSize += written;
+    }
+    batchLength = 0;
+    return true;
+}
+
+bool SmsJournal::openReplay() {
+    if (!mounted) {
+        return false;
+    }
+    replayFile = LittleFS.open(SMS_JOURNAL_PATH, "r");
+    return (bool)replayFile;
+}
+
+bool SmsJournal::nextRecord(SmsJournalRecord& type, SmsMessage& out) {
+    if (!replayFile) {
+        return false;
+    }
+
+    uint8_t header[JournalConst::HEADER_SIZE];
+    if (replayFile.read(header, sizeof(header)) != sizeof(header)) {
+        return false;  // End of log
+    }
+
+    int length = (header[2] << 8) | header[3];
+    uint32_t crc = ((uint32_t)header[4] << 24) | ((uint32_t)header[5] << 16) |
+                   ((uint32_t)header[6] << 8) | header[7];
+    if (header[0] != JournalConst::MAGIC || length > JournalConst::MAX_PAYLOAD) {
+        DEBUG_PRINTLN("WARNING: SMS journal record header invalid, stopping replay");
+        return false;
+    }
+
+    uint8_t payload[JournalConst::MAX_PAYLOAD];
+    if (replayFile.read(payload, length) != (size_t)length || crc32_le(0, payload, length) != crc) {
+        // Torn write at the tail (reset during flush)
+        DEBUG_PRINTLN("WARNING: SMS journal record incomplete, stopping replay");
+        return false;
+    }
+
+    int pos = 0;
+    out = SmsMessage();
+    type = (SmsJournalRecord)header[1];
+
+    if (type == SmsJournalRecord::PART && length >= 8) {
+        out.partInfo.isMultiPart = true;
+        out.partInfo.refNumber = (payload[0] << 8) | payload[1];
+        out.partInfo.ref16Bit = payload[2] != 0;
+        out.partInfo.totalParts = payload[3];
+        out.partInfo.partNumber = payload[4];
+        out.senderClass = (SenderClass)payload[5];
+        out.index = (int16_t)((payload[6] << 8) | payload[7]);
+        pos = 8;
+        return getString(payload, length, pos, out.sender) &&
+               getString(payload, length, pos, out.timestamp) &&
+               getString(payload, length, pos, out.text);
+    }
+
+    if (type == SmsJournalRecord::RELEASE && length >= 4) {
+        out.partInfo.isMultiPart = true;
+        out.partInfo.refNumber = (payload[0] << 8) | payload[1];
+        out.partInfo.ref16Bit = payload[2] != 0;
+        out.partInfo.totalParts = payload[3];
+        pos = 4;
+        return getString(payload, length, pos, out.sender);
+    }
+
+    DEBUG_PRINTF("WARNING: Unknown SMS journal record type %d\n", header[1]);
+    return false;
+}
+
+void SmsJournal::closeReplay() {
+    if (replayFile) {
+        replayFile.close();
+    }
+}
+
+bool SmsJournal::beginRewrite() {
+    if (!mounted || !flush()) {
+        return false;
+    }
+    LittleFS.remove(SMS_JOURNAL_REWRITE_PATH);
+    rewriting = true;
+    return true;
+}
+
+bool SmsJournal::commitRewrite() {
+    bool ok = flush();
+    rewriting = false;
+    if (!ok) {
+        LittleFS.remove(SMS_JOURNAL_REWRITE_PATH);
+        return false;
+    }
+
+    // Nothing live: an empty log needs no file
+    if (!LittleFS.exists(SMS_JOURNAL_REWRITE_PATH)) {
+        LittleFS.remove(SMS_JOURNAL_PATH);
+        fileSize = 0;
+        return true;
+    }
+
+    // LittleFS rename replaces the old log atomically
+    if (!LittleFS.rename(SMS_JOURNAL_REWRITE_PATH, SMS_JOURNAL_PATH)) {
+        DEBUG_PRINTLN("ERROR: Failed to replace SMS journal");
+        return false;
+    }
+
+    File file = LittleFS.open(SMS_JOURNAL_PATH, "r");
+    fileSize = file ? file.size() : 0;
+    if (file) {
+        file.close();
+    }
+    return true;
+}
+
+int SmsJournal::putString(uint8_t* out, int pos, const String& value, int maxLength) {
+    int length = min((int)value.length(), maxLength);
+    out[pos++] = length >> 8;
+    out[pos++] = length & 0xFF;
+    memcpy(out + pos, value.c_str(), length);
+    return pos + length;
+}
+
+bool SmsJournal::getString(const uint8_t* in, int length, int& pos, String& value) {
+    if (pos + 2 > length) {
+        return false;
+    }
+    int fieldLength = (in[pos] << 8) | in[pos + 1];
+    pos += 2;
+    if (pos + fieldLength > length) {
+        return false;
+    }
+    value = "";
+    value.concat((const char*)in + pos, fieldLength);
+    pos += fieldLength;
+    return true;
+}
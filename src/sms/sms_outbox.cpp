@@ -0,0 +1,79 @@
+#include "sms/sms_outbox.h"
+
+// Bulk holds at most CAPACITY - RESERVE entries and the uplink always has one
+// of them dequeued: the mark must sit below that depth, or paging only stops
+// once bulk PDUs are already being parked
+static_assert(SMS_OUTBOX_HIGH_WATER < SMS_OUTBOX_CAPACITY - SMS_OUTBOX_PRIORITY_RESERVE - 1,
+              "SMS_OUTBOX_HIGH_WATER is above what the bulk queue can reach");
+static_assert(SMS_OUTBOX_PRIORITY_RESERVE < SMS_OUTBOX_CAPACITY, "SMS_OUTBOX_PRIORITY_RESERVE leaves no bulk entries");
+
+SmsOutboxEntry* SmsOutbox::push(const SmsMessage& message, int simIndex, uint64_t fingerprint, SmsLane lane,
+                                bool expired) {
+    if (count == SMS_OUTBOX_CAPACITY) {
+        return nullptr;
+    }
+
+    SmsOutboxEntry* entry = entries;
+    while (entry->inUse) {
+        entry++;
+    }
+    entry->message = message;
+    entry->simIndex = simIndex;
+    entry->fingerprint = fingerprint;
+    entry->lane = lane;
+    entry->readAt = 0;
+    entry->attempts = 0;
+    entry->expired = expired;
+    entry->delivered = false;
+    entry->inUse = true;
+    count++;
+    if (lane == SmsLane::BULK) {
+        bulkCount++;
+    }
+    return entry;
+}
+
+void SmsOutbox::release(SmsOutboxEntry* entry) {
+    if (entry == nullptr || !entry->inUse) {
+        return;
+    }
+
+    count--;
+    if (entry->lane == SmsLane::BULK) {
+        bulkCount--;
+    }
+    // Release the strings now rather than when the entry is reused
+    *entry = SmsOutboxEntry();
+}
+
+int SmsOutbox::room(SmsLane lane) const {
+    int free = SMS_OUTBOX_CAPACITY - count;
+    if (lane == SmsLane::PRIORITY) {
+        return free;
+    }
+    // A +CMT may take the reserve, so bulk can run over its quota
+    return max(0, min(free, SMS_OUTBOX_CAPACITY - SMS_OUTBOX_PRIORITY_RESERVE - bulkCount));
+}
+
+bool SmsOutbox::contains(uint64_t fingerprint) const {
+    for (const SmsOutboxEntry& entry : entries) {
+        if (entry.inUse && entry.fingerprint == fingerprint) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SmsOutbox::containsReassembled(const SmsMessage& sms) const {
+    for (const SmsOutboxEntry& entry : entries) {
+        const SmsMessage& queued = entry.message;
+        if (entry.inUse && queued.delivery == SmsDelivery::COMPLETE && queued.partInfo.partNumber == 0 &&
+            queued.partInfo.refNumber == sms.partInfo.refNumber &&
+            queued.partInfo.ref16Bit == sms.partInfo.ref16Bit &&
+            queued.partInfo.totalParts == sms.partInfo.totalParts &&
+            queued.sender == sms.sender) {
+            return true;
+        }
+    }
+    return false;
+}
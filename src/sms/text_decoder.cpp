@@ -1,137 +1,205 @@
 #include "sms/text_decoder.h"
+#include "sms/gsm7_tables.h"
+#include "sms/hex_decoder.h"
 
-// GSM 7-bit default alphabet table (basic) - UTF-8 strings
-const char* const TextDecoder::GSM7_BASIC[128] = {
-    "@", "£", "$", "¥", "è", "é", "ù", "ì", "ò", "Ç", "\n", "Ø", "ø", "\r", "Å", "å",
-    "Δ", "_", "Φ", "Γ", "Λ", "Ω", "Π", "Ψ", "Σ", "Θ", "Ξ", "\x1B", "Æ", "æ", "ß", "É",
-    " ", "!", "\"", "#", "¤", "%", "&", "'", "(", ")", "*", "+", ",", "-", ".", "/",
-    "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", ":", ";", "<", "=", ">", "?",
-    "¡", "A", "B", "C", "D", "E", "F", "G", "H", "I", "J", "K", "L", "M", "N", "O",
-    "P", "Q", "R", "S", "T", "U", "V", "W", "X", "Y", "Z", "Ä", "Ö", "Ñ", "Ü", "§",
-    "¿", "a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l", "m", "n", "o",
-    "p", "q", "r", "s", "t", "u", "v", "w", "x", "y", "z", "ä", "ö", "ñ", "ü", "à"
-};
-
-// GSM 7-bit extended alphabet (escape sequences, accessed via ESC)
-const Gsm7ExtendedChar TextDecoder::GSM7_EXTENDED[10] = {
-    {0x0A, "\f"},  // Form feed
-    {0x14, "^"},   // Caret
-    {0x28, "{"},   // Left brace
-    {0x29, "}"},   // Right brace
-    {0x2F, "\\"},  // Backslash
-    {0x3C, "["},   // Left bracket
-    {0x3D, "~"},   // Tilde
-    {0x3E, "]"},   // Right bracket
-    {0x40, "|"},   // Pipe
-    {0x65, "€"}    // Euro sign
-};
-
-String TextDecoder::decodeGsm7bit(const uint8_t* data, int charCount, int paddingBits) {
-    // GSM 7-bit alphabet unpacking with extended table support
-    // Each character is 7 bits, packed into octets
-    // paddingBits: bit offset for text after UDH (0-6)
+String TextDecoder::decodeGsm7bit(const uint8_t* data, int charCount, int paddingBits,
+                                  const Gsm7Shift& shift) {
+    if (charCount > Gsm7Const::MAX_SEPTETS) {
+        charCount = Gsm7Const::MAX_SEPTETS;
+    }
 
-    String result = "";
-    result.reserve(charCount);
+    // Worst case sized once on the stack, copied into the String in one go
+    char buffer[Gsm7Const::MAX_SEPTETS * Gsm7Const::MAX_UTF8_PER_SEPTET];
+    size_t len = decodeGsm7bitTo(data, charCount, paddingBits, buffer, shift);
 
-    int bitOffset = paddingBits;
-    bool escapeNext = false;
+    String result;
+    result.reserve(len);
+    result.concat(buffer, len);
+    return result;
+}
 
-    for (int i = 0; i < charCount; i++) {
-        int byteIndex = bitOffset / 8;
-        int bitPos = bitOffset % 8;
+// Little-endian load of up to 8 bytes (never reads past count)
+static inline uint64_t loadLe64(const uint8_t* p, int count) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (count >= 8) {
+        uint64_t word;
+        memcpy(&word, p, sizeof(word));
+        return word;
+    }
+#endif
+    uint64_t word = 0;
+    for (int i = 0; i < count && i < 8; i++) {
+        word |= (uint64_t)p[i] << (8 * i);
+    }
+    return word;
+}
 
-        uint8_t char7bit;
+size_t TextDecoder::decodeGsm7bitTo(const uint8_t* data, int charCount, int paddingBits, char* out,
+                                    const Gsm7Shift& shift) {
+    // GSM 7-bit alphabet unpacking with extended table support
+    // 7 packed octets hold exactly 8 septets, so each group is one 64-bit load
+    // paddingBits: bit offset for text after UDH (0-6), the same for every group
 
-        if (bitPos <= 1) {
-            // Character fits in one byte
-            char7bit = (data[byteIndex] >> bitPos) & Gsm7Const::MASK_7BIT;
-        } else {
-            // Character spans two bytes
-            uint8_t lowBits = data[byteIndex] >> bitPos;
-            uint8_t highBits = (byteIndex + 1 < 200) ? (data[byteIndex + 1] << (8 - bitPos)) : 0;
-            char7bit = (lowBits | highBits) & Gsm7Const::MASK_7BIT;
-        }
+    // National language tables are resolved once, the loop is the same for all
+    const Gsm7Utf8* basic = Gsm7Tables::lockingShift(shift.locking);
+    const Gsm7Utf8* extension = Gsm7Tables::singleShift(shift.single);
 
-        // Handle escape sequences
-        if (escapeNext) {
-            // Look up in extended table
-            bool found = false;
-            for (int j = 0; j < 10; j++) {
-                if (GSM7_EXTENDED[j].code == char7bit) {
-                    result += GSM7_EXTENDED[j].replacement;
-                    found = true;
-                    break;
+    char* p = out;
+    bool escapeNext = false;
+    int byteCount = (paddingBits + charCount * 7 + 7) / 8;
+    int bytePos = 0;
+
+    for (int i = 0; i < charCount; i += 8) {
+        // 56 bits of septets + up to 6 padding bits fit in one word
+        uint64_t word = loadLe64(data + bytePos, byteCount - bytePos) >> paddingBits;
+        bytePos += 7;
+
+        int groupSize = charCount - i < 8 ? charCount - i : 8;
+        for (int k = 0; k < groupSize; k++) {
+            uint8_t char7bit = word & Gsm7Const::MASK_7BIT;
+            word >>= 7;
+
+            // Both tables are direct-indexed: no search, no strlen
+            const Gsm7Utf8* entry;
+            if (escapeNext) {
+                escapeNext = false;
+                entry = &extension[char7bit];
+                if (entry->len == 0) {
+                    *p++ = '?'; // Unknown extended character
+                    continue;
                 }
+            } else if (char7bit == Gsm7Const::ESCAPE) {
+                // Escape character - next char is from extended table
+                escapeNext = true;
+                continue;
+            } else {
+                entry = &basic[char7bit];
             }
-            if (!found) {
-                result += '?'; // Unknown extended character
+
+            for (uint8_t b = 0; b < entry->len; b++) {
+                *p++ = entry->bytes[b];
             }
-            escapeNext = false;
-        } else if (char7bit == Gsm7Const::ESCAPE) {
-            // Escape character - next char is from extended table
-            escapeNext = true;
-        } else if (char7bit < 128) {
-            result += GSM7_BASIC[char7bit];
-        } else {
-            result += '?'; // Unknown character
         }
-
-        bitOffset += 7;
     }
 
-    return result;
+    return p - out;
 }
 
-String TextDecoder::decodeUcs2(const uint8_t* data, int byteCount) {
-    // UCS-2 to UTF-8 conversion (supports surrogate pairs for emoji)
-    String result = "";
-    result.reserve(byteCount / 2);
-
+// UCS-2 → UTF-8 kernel shared by the sizing and the writing pass
+// WRITE = false only counts bytes (out may be nullptr)
+template <bool WRITE>
+static size_t transcodeUcs2(const uint8_t* data, int byteCount, char* out) {
+    size_t n = 0;
     int i = 0;
-    uint16_t prevHigh = 0;
 
     // Skip BOM (Byte Order Mark) 0xFEFF or 0xFFFE if present
     if (byteCount >= 2) {
         uint16_t firstChar = (data[0] << 8) | data[1];
-        if (firstChar == 0xFEFF || firstChar == 0xFFFE) {
-            i = 2; // Skip BOM
+        if (firstChar == Ucs2Const::BOM || firstChar == Ucs2Const::BOM_SWAPPED) {
+            i = 2;
         }
     }
 
-    while (i < byteCount - 1) {
-        uint16_t code = (data[i] << 8) | data[i + 1];
+    while (i + 1 < byteCount) {
+        // Fast path: run of ASCII (U+0000-U+007F), 1 byte each
+        while (i + 1 < byteCount && data[i] == 0x00 && data[i + 1] < 0x80) {
+            if (WRITE) out[n] = data[i + 1];
+            n++;
+            i += 2;
+        }
+
+        // Fast path: run of Cyrillic (U+0400-U+04FF), lead byte D0-D3 + continuation
+        while (i + 1 < byteCount && data[i] == 0x04) {
+            uint8_t low = data[i + 1];
+            if (WRITE) {
+                out[n] = 0xD0 | (low >> 6);
+                out[n + 1] = 0x80 | (low & 0x3F);
+            }
+            n += 2;
+            i += 2;
+        }
+
+        if (i + 1 >= byteCount) {
+            break;
+        }
+
+        // General path: one code unit
+        uint32_t code = (data[i] << 8) | data[i + 1];
         i += 2;
 
-        if (code >= 0xD800 && code <= 0xDBFF) {
-            // High surrogate (first half of emoji)
-            prevHigh = code;
+        if (code < 0x80) {
+            if (WRITE) out[n] = char(code);
+            n += 1;
             continue;
-        } else if (code >= 0xDC00 && code <= 0xDFFF && prevHigh) {
-            // Low surrogate - combine with high surrogate
-            uint32_t fullCode = 0x10000 + (((prevHigh - 0xD800) << 10) | (code - 0xDC00));
-
-            result += char(0xF0 | (fullCode >> 18));
-            result += char(0x80 | ((fullCode >> 12) & 0x3F));
-            result += char(0x80 | ((fullCode >> 6) & 0x3F));
-            result += char(0x80 | (fullCode & 0x3F));
-            prevHigh = 0;
+        }
+        if (code < 0x800) {
+            if (WRITE) {
+                out[n] = 0xC0 | (code >> 6);
+                out[n + 1] = 0x80 | (code & 0x3F);
+            }
+            n += 2;
             continue;
         }
 
-        // Regular UCS-2 character
-        if (code < 0x80) {
-            result += char(code);
-        } else if (code < 0x800) {
-            result += char(0xC0 | (code >> 6));
-            result += char(0x80 | (code & 0x3F));
-        } else {
-            result += char(0xE0 | (code >> 12));
-            result += char(0x80 | ((code >> 6) & 0x3F));
-            result += char(0x80 | (code & 0x3F));
+        if (code >= Ucs2Const::HIGH_SURROGATE && code < Ucs2Const::SURROGATE_END) {
+            uint16_t next = (i + 1 < byteCount) ? ((data[i] << 8) | data[i + 1]) : 0;
+            bool pair = code < Ucs2Const::LOW_SURROGATE &&
+                        next >= Ucs2Const::LOW_SURROGATE && next < Ucs2Const::SURROGATE_END;
+            if (pair) {
+                // High + low surrogate (e.g. emoji) → one 4-byte sequence
+                code = 0x10000 + (((code - Ucs2Const::HIGH_SURROGATE) << 10) | (next - Ucs2Const::LOW_SURROGATE));
+                i += 2;
+                if (WRITE) {
+                    out[n] = 0xF0 | (code >> 18);
+                    out[n + 1] = 0x80 | ((code >> 12) & 0x3F);
+                    out[n + 2] = 0x80 | ((code >> 6) & 0x3F);
+                    out[n + 3] = 0x80 | (code & 0x3F);
+                }
+                n += 4;
+                continue;
+            }
+            code = Ucs2Const::REPLACEMENT; // Unpaired surrogate
         }
+
+        if (WRITE) {
+            out[n] = 0xE0 | (code >> 12);
+            out[n + 1] = 0x80 | ((code >> 6) & 0x3F);
+            out[n + 2] = 0x80 | (code & 0x3F);
+        }
+        n += 3;
+    }
+
+    return n;
+}
+
+size_t TextDecoder::ucs2Utf8Length(const uint8_t* data, int byteCount) {
+    return transcodeUcs2<false>(data, byteCount, nullptr);
+}
+
+size_t TextDecoder::decodeUcs2To(const uint8_t* data, int byteCount, char* out) {
+    return transcodeUcs2<true>(data, byteCount, out);
+}
+
+String TextDecoder::decodeUcs2(const uint8_t* data, int byteCount) {
+    // UCS-2 to UTF-8 conversion (supports surrogate pairs for emoji)
+    // Exact size first, so the result is allocated once and filled in one copy
+    size_t len = ucs2Utf8Length(data, byteCount);
+
+    char stackBuffer[Ucs2Const::STACK_OUTPUT];
+    char* buffer = len <= sizeof(stackBuffer) ? stackBuffer : (char*)malloc(len);
+    if (buffer == nullptr) {
+        return "";
     }
 
+    decodeUcs2To(data, byteCount, buffer);
+
+    String result;
+    result.reserve(len);
+    result.concat(buffer, len);
+
+    if (buffer != stackBuffer) {
+        free(buffer);
+    }
     return result;
 }
 
@@ -141,20 +209,21 @@ String TextDecoder::decodeUcs2Hex(const String& hexStr) {
         return "";
     }
 
-    String out = "";
-    for (int i = 0; i + 3 < hexStr.length(); i += 4) {
-        uint16_t code = (uint16_t)strtol(hexStr.substring(i, i + 4).c_str(), NULL, 16);
+    // Same kernel as decodeUcs2, after one table-driven hex pass
+    size_t byteCount = hexStr.length() / 2;
+    uint8_t stackBytes[Ucs2Const::STACK_OUTPUT];
+    uint8_t* bytes = byteCount <= sizeof(stackBytes) ? stackBytes : (uint8_t*)malloc(byteCount);
+    if (bytes == nullptr) {
+        return "";
+    }
 
-        if (code < 0x80) {
-            out += char(code);
-        } else if (code < 0x800) {
-            out += char(0xC0 | (code >> 6));
-            out += char(0x80 | (code & 0x3F));
-        } else {
-            out += char(0xE0 | (code >> 12));
-            out += char(0x80 | ((code >> 6) & 0x3F));
-            out += char(0x80 | (code & 0x3F));
-        }
+    String out;
+    if (HexDecoder::decode(hexStr.c_str(), hexStr.length(), bytes, byteCount) >= 0) {
+        out = decodeUcs2(bytes, byteCount);
+    }
+
+    if (bytes != stackBytes) {
+        free(bytes);
     }
     return out;
 }
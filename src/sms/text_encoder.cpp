@@ -0,0 +1,273 @@
+#include "sms/text_encoder.h"
+#include "sms/text_decoder.h"
+#include "sms/gsm7_tables.h"
+#include <algorithm>
+
+namespace {
+
+constexpr uint8_t GSM7_NONE = 0xFF;       // Not representable
+constexpr uint8_t GSM7_EXTENSION = 0x80;  // Code lives in the extension table
+
+// Next code point from UTF-8, advancing pos
+// Malformed or truncated sequences yield U+FFFD and consume one byte
+uint32_t nextCodePoint(const uint8_t* s, size_t len, size_t& pos) {
+    uint8_t lead = s[pos];
+    if (lead < 0x80) {
+        pos++;
+        return lead;
+    }
+
+    int extra;
+    uint32_t cp;
+    if ((lead & 0xE0) == 0xC0) {
+        extra = 1;
+        cp = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+        extra = 2;
+        cp = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+        extra = 3;
+        cp = lead & 0x07;
+    } else {
+        pos++;
+        return Ucs2Const::REPLACEMENT;
+    }
+
+    if (pos + extra >= len) {
+        pos++;
+        return Ucs2Const::REPLACEMENT;
+    }
+    for (int i = 1; i <= extra; i++) {
+        uint8_t c = s[pos + i];
+        if ((c & 0xC0) != 0x80) {
+            pos++;
+            return Ucs2Const::REPLACEMENT;
+        }
+        cp = (cp << 6) | (c & 0x3F);
+    }
+
+    pos += extra + 1;
+    return cp;
+}
+
+// Reverse of Gsm7Tables, built once from the decoder tables themselves
+struct Gsm7ReverseMap {
+    struct Entry {
+        uint16_t codePoint;
+        uint8_t code;  // Septet, GSM7_EXTENSION set for the extension table
+    };
+
+    uint8_t ascii[128];  // Direct index for U+0000-U+007F
+    Entry others[64];    // Non-ASCII, sorted by code point
+    int otherCount;
+
+    Gsm7ReverseMap() : otherCount(0) {
+        memset(ascii, GSM7_NONE, sizeof(ascii));
+
+        // Extension first so the default alphabet wins on any overlap
+        add(Gsm7Tables::EXTENDED, GSM7_EXTENSION);
+        add(Gsm7Tables::BASIC, 0);
+
+        std::sort(others, others + otherCount, [](const Entry& a, const Entry& b) {
+            return a.codePoint < b.codePoint;
+        });
+    }
+
+    void add(const Gsm7Utf8* table, uint8_t flag) {
+        for (int code = 0; code < 128; code++) {
+            const Gsm7Utf8& entry = table[code];
+            if (entry.len == 0) {
+                continue;
+            }
+            size_t pos = 0;
+            uint32_t cp = nextCodePoint((const uint8_t*)entry.bytes, entry.len, pos);
+            if (cp < 0x80) {
+                ascii[cp] = code | flag;
+                continue;
+            }
+
+            Entry* existing = nullptr;
+            for (int i = 0; i < otherCount; i++) {
+                if (others[i].codePoint == cp) existing = &others[i];
+            }
+            if (existing) {
+                existing->code = code | flag;
+            } else if (otherCount < (int)(sizeof(others) / sizeof(others[0]))) {
+                others[otherCount].codePoint = cp;
+                others[otherCount].code = code | flag;
+                otherCount++;
+            }
+        }
+    }
+
+    uint8_t lookup(uint32_t cp) const {
+        if (cp < 0x80) {
+            return ascii[cp];
+        }
+        int lo = 0;
+        int hi = otherCount - 1;
+        while (lo <= hi) {
+            int mid = (lo + hi) / 2;
+            if (others[mid].codePoint == cp) return others[mid].code;
+            if (others[mid].codePoint < cp) lo = mid + 1;
+            else hi = mid - 1;
+        }
+        return GSM7_NONE;
+    }
+};
+
+const Gsm7ReverseMap& reverseMap() {
+    static const Gsm7ReverseMap map;
+    return map;
+}
+
+// Greedy part counter: a character of `cost` units never straddles two parts
+struct PartCounter {
+    int total = 0;
+    int parts = 1;
+    int fill = 0;
+
+    void add(int cost, int perPart) {
+        total += cost;
+        if (fill + cost > perPart) {
+            parts++;
+            fill = 0;
+        }
+        fill += cost;
+    }
+
+    int segments(int single) const {
+        if (total == 0) return 0;
+        return total <= single ? 1 : parts;
+    }
+};
+
+} // namespace
+
+SegmentEstimate TextEncoder::estimate(const String& text) {
+    return estimate(text.c_str(), text.length());
+}
+
+SegmentEstimate TextEncoder::estimate(const char* utf8, size_t len) {
+    const Gsm7ReverseMap& map = reverseMap();
+    const uint8_t* s = (const uint8_t*)utf8;
+
+    // One pass counts both encodings; GSM7 is dropped on the first miss
+    PartCounter gsm7;
+    PartCounter ucs2;
+    bool gsm7Ok = true;
+
+    size_t pos = 0;
+    while (pos < len) {
+        uint32_t cp = nextCodePoint(s, len, pos);
+
+        if (gsm7Ok) {
+            uint8_t code = map.lookup(cp);
+            if (code == GSM7_NONE) {
+                gsm7Ok = false;
+            } else {
+                gsm7.add((code & GSM7_EXTENSION) ? 2 : 1, SegmentConst::GSM7_MULTI);
+            }
+        }
+        ucs2.add(cp >= 0x10000 ? 2 : 1, SegmentConst::UCS2_MULTI);
+    }
+
+    SegmentEstimate result;
+    if (gsm7Ok) {
+        result.encoding = SmsEncoding::GSM7;
+        result.units = gsm7.total;
+        result.segments = gsm7.segments(SegmentConst::GSM7_SINGLE);
+    } else {
+        result.encoding = SmsEncoding::UCS2;
+        result.units = ucs2.total;
+        result.segments = ucs2.segments(SegmentConst::UCS2_SINGLE);
+    }
+    return result;
+}
+
+bool TextEncoder::isGsm7Compatible(const char* utf8, size_t len) {
+    const Gsm7ReverseMap& map = reverseMap();
+    const uint8_t* s = (const uint8_t*)utf8;
+
+    size_t pos = 0;
+    while (pos < len) {
+        if (map.lookup(nextCodePoint(s, len, pos)) == GSM7_NONE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int TextEncoder::encodeGsm7bit(const char* utf8, size_t len, uint8_t* out, size_t outCap,
+                                int paddingBits) {
+    const Gsm7ReverseMap& map = reverseMap();
+    const uint8_t* s = (const uint8_t*)utf8;
+
+    // Septets are packed LSB first, continuing the bit stream after the padding
+    uint32_t acc = 0;
+    int accBits = paddingBits;
+    size_t outLen = 0;
+    int septets = 0;
+
+    size_t pos = 0;
+    while (pos < len) {
+        uint8_t code = map.lookup(nextCodePoint(s, len, pos));
+        if (code == GSM7_NONE) {
+            return -1;
+        }
+
+        uint8_t pair[2];
+        int count = 0;
+        if (code & GSM7_EXTENSION) {
+            pair[count++] = Gsm7Const::ESCAPE;
+        }
+        pair[count++] = code & Gsm7Const::MASK_7BIT;
+
+        for (int i = 0; i < count; i++) {
+            acc |= (uint32_t)pair[i] << accBits;
+            accBits += 7;
+            septets++;
+            while (accBits >= 8) {
+                if (outLen >= outCap) return -1;
+                out[outLen++] = acc & 0xFF;
+                acc >>= 8;
+                accBits -= 8;
+            }
+        }
+    }
+
+    if (accBits > 0) {
+        if (outLen >= outCap) return -1;
+        out[outLen++] = acc & 0xFF;
+    }
+
+    return septets;
+}
+
+int TextEncoder::encodeUcs2(const char* utf8, size_t len, uint8_t* out, size_t outCap) {
+    const uint8_t* s = (const uint8_t*)utf8;
+    size_t outLen = 0;
+
+    size_t pos = 0;
+    while (pos < len) {
+        uint32_t cp = nextCodePoint(s, len, pos);
+
+        uint16_t units[2];
+        int count = 0;
+        if (cp >= 0x10000) {
+            cp -= 0x10000;
+            units[count++] = Ucs2Const::HIGH_SURROGATE + (cp >> 10);
+            units[count++] = Ucs2Const::LOW_SURROGATE + (cp & 0x3FF);
+        } else {
+            units[count++] = cp;
+        }
+
+        for (int i = 0; i < count; i++) {
+            if (outLen + 2 > outCap) return -1;
+            out[outLen++] = units[i] >> 8;
+            out[outLen++] = units[i] & 0xFF;
+        }
+    }
+
+    return (int)outLen;
+}
@@ -1,7 +1,20 @@
 #include "sms_manager.h"
-#include "sms/pdu_parser.h"
+#include "utilities.h"
+#include "event_bus.h"
 
-SmsManager::SmsManager(TinyGsm& m) : modem(m), initialized(false) {}
+#if SMS_DIRECT_DELIVERY
+// The network gives up on our RP-ACK after TR2M (12-20 s, 3GPP TS 24.011);
+// the ME then answers it itself and stops routing +CMT to us
+static_assert(SMS_DIRECT_ACK_TIMEOUT < 12000, "SMS_DIRECT_ACK_TIMEOUT must end well inside TR2M");
+#endif
+
+volatile bool SmsManager::ringFlag = false;
+
+SmsManager::SmsManager(TinyGsm& m) : modem(m), initialized(false), arrivalPending(false), urcLength(0),
+                                    directPdu(false), directReady(false), directRaw(), storageName(SMS_STORAGE_FALLBACK),
+                                    storageUsed(0), storageTotal(0), storageFull(false),
+                                    readMask(), seenMask(), inFlightMask(), retryMask(), untracked(false),
+                                    fullScanNeeded(true), storageMismatch(0), pageCursor(-1) {}
 
 bool SmsManager::init() {
     DEBUG_PRINTLN("=== SMS Manager Initialization (PDU Mode) ===");
@@ -20,116 +33,504 @@ bool SmsManager::init() {
         DEBUG_PRINTLN("WARNING: Failed to set SMS parameters");
     }
 
+    if (!selectStorage()) {
+        DEBUG_PRINTLN("WARNING: Failed to select SMS storage, using modem default");
+    }
+
+    enableArrivalIndications();
+
     initialized = true;
     DEBUG_PRINTLN("SMS Manager initialized successfully");
     return true;
 }
 
-bool SmsManager::hasNewSms() {
-    if (!initialized) {
-        DEBUG_PRINTLN("ERROR: SMS Manager not initialized");
-        return false;
+bool SmsManager::selectStorage() {
+    // Same storage for reading/deleting, writing and receiving, so every
+    // incoming SMS shows up in AT+CMGL and is freed by AT+CMGD
+    const char* candidates[] = { SMS_STORAGE_PREFERRED, SMS_STORAGE_FALLBACK };
+    for (const char* name : candidates) {
+        String response = "";
+        String mem = String("\"") + name + "\"";
+        modem.sendAT("+CPMS=", mem, ",", mem, ",", mem);
+        if (modem.waitResponse(5000UL, response) == 1 && parseStorage(response)) {
+            storageName = name;
+            DEBUG_PRINTF("SMS storage %s: %d/%d used\n", name, storageUsed, storageTotal);
+            return true;
+        }
+        DEBUG_PRINTF("WARNING: SMS storage %s not available\n", name);
     }
+    return false;
+}
 
+bool SmsManager::refreshStorage() {
+    // +CPMS: <mem1>,<used1>,<total1>,<mem2>,<used2>,<total2>,<mem3>,<used3>,<total3>
     String response = "";
-    modem.sendAT("+CMGL=" + String(SmsStatus::ALL));
-    modem.waitResponse(10000UL, response);
+    modem.sendAT("+CPMS?");
+    if (modem.waitResponse(5000UL, response) != 1 || !parseStorage(response)) {
+        DEBUG_PRINTLN("WARNING: Failed to query SMS storage");
+        return false;
+    }
+    setStorageUsed(storageUsed);
+
+    // Every message on the SIM should be known once it's listed; a single
+    // mismatch may be an SMS arriving right now, a second one is drift
+    int known = countBits(readMask);
+    if (untracked || pageCursor >= 0 || storageUsed == known) {
+        storageMismatch = 0;
+    } else if (++storageMismatch >= 2) {
+        DEBUG_PRINTF("WARNING: SIM holds %d SMS, %d known; full rescan\n", storageUsed, known);
+        fullScanNeeded = true;
+        arrivalPending = true;
+        storageMismatch = 0;
+    }
+    return true;
+}
 
-    return response.indexOf("+CMGL:") >= 0;
+void SmsManager::setStorageUsed(int used) {
+    storageUsed = max(used, 0);
+    if (storageFull && storageTotal - storageUsed > SMS_STORAGE_DRAIN_FREE) {
+        storageFull = false;
+        DEBUG_PRINTLN("SMS storage has room again");
+    }
 }
 
-bool SmsManager::getSmsList(int* indices, int maxCount, int& count) {
-    if (!initialized) {
-        DEBUG_PRINTLN("ERROR: SMS Manager not initialized");
+bool SmsManager::parseStorage(const String& response) {
+    int pos = response.indexOf("+CPMS:");
+    if (pos < 0) {
         return false;
     }
 
-    count = 0;
-    String response = "";
+    // Set form lists only numbers, query form adds quoted storage names:
+    // the receive storage (<mem3>) is the last <used>,<total> pair either way
+    int used = -1;
+    int total = -1;
+    int found = 0;
+    const char* p = response.c_str() + pos + 6;
+    while (*p != '\0' && *p != '\r' && *p != '\n') {
+        if (*p >= '0' && *p <= '9') {
+            used = total;
+            total = atoi(p);
+            found++;
+            while (*p >= '0' && *p <= '9') {
+                p++;
+            }
+        } else if (*p == '"') {
+            const char* close = strchr(p + 1, '"');
+            p = close ? close + 1 : p + 1;
+        } else {
+            p++;
+        }
+    }
+    if (found < 2 || found % 2 != 0) {
+        return false;
+    }
+
+    if (total <= 0) {
+        return false;
+    }
+    storageUsed = used;
+    storageTotal = total;
+    return true;
+}
+
+void SmsManager::enableArrivalIndications() {
+#if SMS_DIRECT_DELIVERY
+    // Phase 2+ service: the TE acknowledges each +CMT with AT+CNMA
+    modem.sendAT("+CSMS=1");
+    if (modem.waitResponse() != 1) {
+        DEBUG_PRINTLN("WARNING: Failed to select SMS service phase 2+");
+    }
+
+    routeDirectSms();
+#else
+    // New SMS stored in memory → +CMTI: "SM",<index>
+    modem.sendAT("+CNMI=2,1,0,0,0");
+    if (modem.waitResponse() != 1) {
+        DEBUG_PRINTLN("WARNING: Failed to enable new SMS indications, relying on polling");
+    } else {
+        DEBUG_PRINTLN("New SMS indications (+CMTI) enabled");
+    }
+#endif
+
+#ifdef MODEM_RING_PIN
+    // Pulse RI on URCs, so an arrival is caught even while a URC is
+    // swallowed by another AT command's response
+    modem.sendAT("+CFGRI=1");
+    if (modem.waitResponse() != 1) {
+        DEBUG_PRINTLN("WARNING: Failed to enable RING indication");
+    }
+    pinMode(MODEM_RING_PIN, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(MODEM_RING_PIN), onRing, FALLING);
+    DEBUG_PRINTF("RING interrupt on GPIO %d\n", MODEM_RING_PIN);
+#endif
+}
+
+bool SmsManager::routeDirectSms() {
+    // New SMS routed to us → +CMT: [<alpha>],<length>\r\n<pdu>
+    modem.sendAT("+CNMI=2,2,0,0,0");
+    if (modem.waitResponse() != 1) {
+        DEBUG_PRINTLN("WARNING: Failed to enable direct SMS delivery, relying on polling");
+        return false;
+    }
+    DEBUG_PRINTLN("Direct SMS delivery (+CMT) enabled");
+    return true;
+}
+
+void IRAM_ATTR SmsManager::onRing() {
+    ringFlag = true;
+    EventBus::signalFromIsr(EventBit::MODEM_RING);
+}
 
-    // Get ALL messages
-    modem.sendAT("+CMGL=" + String(SmsStatus::ALL));
-    modem.waitResponse(10000UL, response);
-
-    // Parse response for SMS indices
-    // Format: +CMGL: <index>,<stat>,<alpha>,<length>\r\n<pdu>
-    int pos = 0;
-    while (count < maxCount && (pos = response.indexOf("+CMGL: ", pos)) >= 0) {
-        pos += 7; // Skip "+CMGL: "
-        int endPos = response.indexOf(',', pos);
-        if (endPos > pos) {
-            String indexStr = response.substring(pos, endPos);
-            indices[count++] = indexStr.toInt();
-            pos = endPos;
+bool SmsManager::pollArrivals() {
+    // URCs arrive unsolicited between AT commands
+    while (modem.stream.available() > 0) {
+        char c = modem.stream.read();
+
+        if (directPdu) {
+            if (feedDirectPdu(c)) {
+                break;  // One at a time: the modem waits for our acknowledgement
+            }
+            continue;
+        }
+
+        if (c == '\n') {
+            urcLine[urcLength] = '\0';
+            handleUrc(urcLine);
+            urcLength = 0;
+        } else if (c != '\r' && urcLength < (int)sizeof(urcLine) - 1) {
+            urcLine[urcLength++] = c;
         }
     }
 
-    DEBUG_PRINTF("Found %d SMS messages\n", count);
-    return count > 0;
+    if (ringFlag) {
+        ringFlag = false;
+        DEBUG_PRINTLN("RING: modem signalled an event");
+        arrivalPending = true;
+    }
+
+    bool pending = arrivalPending;
+    arrivalPending = false;
+    return pending;
 }
 
-SmsMessage SmsManager::readSms(int index) {
-    SmsMessage sms;
+bool SmsManager::feedDirectPdu(char c) {
+    // PDU line of a +CMT: converted to octets as it arrives
+    PduStreamParser::Result result = pduStream.feed(c);
+    if (result == PduStreamParser::Result::NEED_MORE) {
+        return false;
+    }
 
-    if (!initialized) {
-        DEBUG_PRINTLN("ERROR: SMS Manager not initialized");
-        return sms;
+    // Malformed PDUs are handed out too (length 0): the caller still has to answer the network
+    directPdu = false;
+    directReady = true;
+    directRaw.index = SMS_INDEX_DIRECT;
+    directRaw.length = 0;
+    directRaw.readAt = millis();
+    if (result == PduStreamParser::Result::COMPLETE) {
+        directRaw.length = pduStream.length();
+        memcpy(directRaw.pdu, pduStream.data(), directRaw.length);
+        DEBUG_PRINTLN("SMS received directly (+CMT)");
+    } else {
+        DEBUG_PRINTLN("ERROR: Malformed +CMT PDU");
+    }
+    return true;
+}
+
+bool SmsManager::takeDirectPdu(SmsRawPdu& out) {
+    if (!directReady) {
+        return false;
     }
+    out = directRaw;
+    return true;
+}
 
-    DEBUG_PRINTF("Reading SMS at index %d\n", index);
+bool SmsManager::storeDirectPdu(const SmsRawPdu& raw, int& index) {
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+    index = -1;
 
-    String response = "";
-    modem.sendAT("+CMGR=" + String(index));
-    if (modem.waitResponse(10000UL, response) != 1) {
-        DEBUG_PRINTLN("ERROR: Failed to read SMS");
-        return sms;
+    // AT+CMGW takes the TPDU length: the SMSC address isn't counted
+    int tpduLength = raw.length > 0 ? raw.length - 1 - raw.pdu[0] : 0;
+    if (tpduLength <= 0) {
+        return false;
     }
 
-    DEBUG_PRINTLN("=== RAW AT RESPONSE ===");
-    DEBUG_PRINTLN(response);
-    DEBUG_PRINTLN("=== END RAW RESPONSE ===");
+    // Written REC READ: it's listed only by ALL, like every message we have read
+    unsigned long start = millis();
+    modem.sendAT("+CMGW=", tpduLength, ",", SmsStatus::REC_READ);
+    if (modem.waitResponse(SMS_DIRECT_ACK_TIMEOUT, GF(">")) != 1) {
+        DEBUG_PRINTLN("ERROR: No +CMGW prompt");
+        return false;
+    }
+    char hex[2 * PduConst::MAX_PDU_OCTETS];
+    for (int i = 0; i < raw.length; i++) {
+        hex[2 * i] = HEX_DIGITS[raw.pdu[i] >> 4];
+        hex[2 * i + 1] = HEX_DIGITS[raw.pdu[i] & 0x0F];
+    }
+    modem.stream.write((const uint8_t*)hex, 2 * raw.length);
+    modem.stream.write((uint8_t)0x1A);  // Ctrl-Z ends the PDU
 
-    // Extract PDU hex string from response
-    // Format: +CMGR: <stat>,<alpha>,<length>\r\n<pdu>\r\nOK
-    int cmgrPos = response.indexOf("+CMGR:");
-    if (cmgrPos < 0) {
-        DEBUG_PRINTLN("ERROR: Invalid AT response");
-        return sms;
+    // +CMGW: <index>
+    unsigned long elapsed = millis() - start;
+    unsigned long remaining = elapsed < SMS_DIRECT_ACK_TIMEOUT ? SMS_DIRECT_ACK_TIMEOUT - elapsed : 1;
+    if (modem.waitResponse(remaining, GF("+CMGW:")) != 1) {
+        DEBUG_PRINTLN("ERROR: Failed to store +CMT message (storage full?)");
+        return false;
     }
+    index = modem.stream.parseInt();
+    modem.waitResponse();
 
-    int pduStart = response.indexOf('\n', cmgrPos);
-    if (pduStart < 0) {
-        DEBUG_PRINTLN("ERROR: No PDU found");
-        return sms;
+    // Read, handed out and queued, like an SMS listed by readPage()
+    setBit(readMask, index, true);
+    setBit(seenMask, index, true);
+    setBit(inFlightMask, index, true);
+    if (index < 0 || index > SmsDeleteConst::MAX_INDEX) {
+        untracked = true;
     }
-    pduStart++; // Skip newline
+    setStorageUsed(storageUsed + 1);
+    DEBUG_PRINTF("+CMT message stored at index %d\n", index);
+    return true;
+}
+
+bool SmsManager::acknowledge(bool accepted) {
+    directReady = false;
 
-    int pduEnd = response.indexOf("\r\nOK", pduStart);
-    if (pduEnd < 0) {
-        pduEnd = response.length();
+    // PDU mode: AT+CNMA (RP-ACK) or AT+CNMA=2 (RP-ERROR)
+    if (accepted) {
+        modem.sendAT("+CNMA");
+    } else {
+        modem.sendAT("+CNMA=2");
+    }
+    if (modem.waitResponse() != 1) {
+        // Acknowledgement window missed: the ME has answered the network
+        // itself and reset +CNMI mt/ds to 0, so route +CMT to us again.
+        // A redelivered copy is caught by the duplicate filter
+        DEBUG_PRINTLN("WARNING: +CNMA rejected");
+        routeDirectSms();
+        return false;
+    }
+    DEBUG_PRINTLN(accepted ? "SMS acknowledged (RP-ACK)" : "SMS rejected (RP-ERROR), network will retry");
+    return true;
+}
+
+bool SmsManager::handleUrc(const char* line) {
+    // +CMT: [<alpha>],<length> — PDU line follows
+    if (strncmp(line, "+CMT:", 5) == 0) {
+        const char* lengthField = strrchr(line, ',');
+        pduStream.reset(lengthField ? atoi(lengthField + 1) : 0);
+        directPdu = true;
+        return true;
     }
 
-    String pduHex = response.substring(pduStart, pduEnd);
-    pduHex.trim();
+    // Storage full: the network holds further SMS until slots are freed
+    // (A76xx: "+SMS FULL", some firmware "SMS FULL" / "+SMSFULL")
+    if (strcmp(line, "+SMS FULL") == 0 || strcmp(line, "SMS FULL") == 0 || strcmp(line, "+SMSFULL") == 0) {
+        DEBUG_PRINTLN("WARNING: SMS storage full, draining");
+        storageFull = true;
+        arrivalPending = true;
+        return true;
+    }
 
-    // Delegate parsing to PduParser
-    if (PduParser::parse(pduHex, sms)) {
-        sms.index = index;
-        DEBUG_PRINTLN("SMS read successfully");
-        DEBUG_PRINT("From: ");
-        DEBUG_PRINTLN(sms.sender);
-        DEBUG_PRINT("Time: ");
-        DEBUG_PRINTLN(sms.timestamp);
-        if (sms.partInfo.isMultiPart) {
-            DEBUG_PRINTF("Part: %d/%d (ref: %d)\n", sms.partInfo.partNumber, sms.partInfo.totalParts, sms.partInfo.refNumber);
-        }
-        DEBUG_PRINT("Text: ");
-        DEBUG_PRINTLN(sms.text);
+    // +CMTI: "SM",<index>
+    if (strncmp(line, "+CMTI:", 6) != 0) {
+        return false;
+    }
+    const char* indexField = strrchr(line, ',');
+    DEBUG_PRINTF("New SMS indication (index %d)\n", indexField ? atoi(indexField + 1) : -1);
+    arrivalPending = true;
+    return true;
+}
+
+void SmsManager::setInFlight(int index, bool inFlight) {
+    // Untracked indices: the duplicate filter catches a re-read
+    setBit(inFlightMask, index, inFlight);
+}
+
+void SmsManager::release(int index) {
+    setBit(inFlightMask, index, false);
+    setBit(seenMask, index, false);
+    setBit(retryMask, index, true);
+}
+
+void SmsManager::setBit(uint32_t* mask, int index, bool value) {
+    if (index < 0 || index > SmsDeleteConst::MAX_INDEX) {
+        return;
+    }
+    if (value) {
+        mask[index / 32] |= 1UL << (index % 32);
     } else {
-        DEBUG_PRINTLN("ERROR: Failed to parse PDU");
+        mask[index / 32] &= ~(1UL << (index % 32));
     }
+}
 
-    return sms;
+int SmsManager::countBits(const uint32_t* mask) {
+    int bits = 0;
+    for (int w = 0; w < SmsDeleteConst::MASK_WORDS; w++) {
+        bits += __builtin_popcount(mask[w]);
+    }
+    return bits;
+}
+
+bool SmsManager::readPage(SmsRawPdu* pdus, int maxCount, int& count) {
+    if (!initialized) {
+        DEBUG_PRINTLN("ERROR: SMS Manager not initialized");
+        return false;
+    }
+
+    count = 0;
+    urcLength = 0;  // A partial URC line would be mixed into the listing
+
+    // Full rescan: forget everything but queued messages and relist the SIM
+    bool fullScan = fullScanNeeded && pageCursor < 0;
+    if (fullScan) {
+        DEBUG_PRINTLN("Full SMS rescan");
+        memset(readMask, 0, sizeof(readMask));
+        memcpy(seenMask, inFlightMask, sizeof(seenMask));
+        untracked = false;
+        fullScanNeeded = false;
+    }
+
+    // A released SMS is REC READ by now: only ALL lists it again
+    bool retryScan = pageCursor < 0 && countBits(retryMask) > 0;
+    if (retryScan) {
+        DEBUG_PRINTF("Re-reading %d SMS released unconsumed\n", countBits(retryMask));
+        memset(retryMask, 0, sizeof(retryMask));
+    }
+
+    // Later pages of a pass list ALL: the first page marked the rest read
+    int status = fullScan || retryScan || pageCursor >= 0 ? SmsStatus::ALL : SmsStatus::REC_UNREAD;
+
+    // One transaction: CMGL already carries every PDU, no per-index CMGR needed
+    modem.sendAT("+CMGL=" + String(status));
+
+    // Consume the response straight from the UART instead of buffering it:
+    // +CMGL: <index>,<stat>,<alpha>,<length>\r\n<pdu>\r\n ... OK
+    // Header lines go to a small line buffer, PDU lines to the stream parser.
+    char line[64];
+    int lineLen = 0;
+    int pduIndex = -1;  // >= 0 while a PDU line is being received
+    bool pduTaken = false;  // PDU belongs to this page
+    bool morePages = false;
+    bool resync = false;
+    int lastTaken = -1;
+    int listed = 0;
+    bool finished = false;
+    uint32_t lastByte = millis();
+
+    while (!finished && millis() - lastByte < 10000UL) {
+        if (modem.stream.available() <= 0) {
+            TINY_GSM_YIELD();
+            continue;
+        }
+        char c = modem.stream.read();
+        lastByte = millis();
+
+        if (directPdu) {
+            // +CMT interleaved with the listing
+            feedDirectPdu(c);
+            continue;
+        }
+
+        if (pduIndex >= 0) {
+            PduStreamParser::Result result = pduStream.feed(c);
+            if (result == PduStreamParser::Result::NEED_MORE) {
+                continue;
+            }
+
+            if (!pduTaken) {
+                // Before the cursor, already handed out, or no room
+            } else if (result == PduStreamParser::Result::COMPLETE) {
+                SmsRawPdu& raw = pdus[count++];
+                raw.index = pduIndex;
+                raw.length = pduStream.length();
+                raw.readAt = millis();
+                memcpy(raw.pdu, pduStream.data(), raw.length);
+                setBit(inFlightMask, pduIndex, true);
+            } else if (result == PduStreamParser::Result::ERROR) {
+                // Possibly a garbled UART line: read it again next pass
+                DEBUG_PRINTF("ERROR: Malformed PDU at index %d\n", pduIndex);
+                release(pduIndex);
+            }
+            pduIndex = -1;
+            continue;
+        }
+
+        if (c == '\n') {
+            line[lineLen] = '\0';
+            if (strncmp(line, "+CMGL: ", 7) == 0) {
+                // Header: index first, TPDU length last
+                pduIndex = atoi(line + 7);
+                listed++;
+                if (pduIndex < 0 || pduIndex > SmsDeleteConst::MAX_INDEX) {
+                    untracked = true;
+                } else if (status == SmsStatus::REC_UNREAD && testBit(readMask, pduIndex)) {
+                    // Unread SMS in a slot we hold as read: it was deleted behind our back
+                    resync = true;
+                    setBit(seenMask, pduIndex, false);
+                }
+                setBit(readMask, pduIndex, true);
+
+                bool wanted = pduIndex > pageCursor && !testBit(seenMask, pduIndex);
+                pduTaken = wanted && count < maxCount;
+                if (pduTaken) {
+                    lastTaken = pduIndex;
+                    setBit(seenMask, pduIndex, true);
+                } else if (wanted) {
+                    // No room on this page: the next one starts here
+                    morePages = true;
+                }
+                const char* lengthField = strrchr(line, ',');
+                pduStream.reset(lengthField ? atoi(lengthField + 1) : 0);
+            } else if (handleUrc(line)) {
+                // New SMS arrived during the listing; it may not be in it
+            } else if (strcmp(line, "OK") == 0) {
+                finished = true;
+            } else if (strstr(line, "ERROR") != nullptr) {
+                DEBUG_PRINTLN("ERROR: Failed to list SMS");
+                fullScanNeeded = true;
+                pageCursor = -1;
+                return false;
+            }
+            lineLen = 0;
+        } else if (c != '\r' && lineLen < (int)sizeof(line) - 1) {
+            line[lineLen++] = c;
+        }
+    }
+
+    if (!finished) {
+        // Listing incomplete: unknown messages may now be marked read
+        DEBUG_PRINTLN("ERROR: Timeout while listing SMS");
+        fullScanNeeded = true;
+    } else if (fullScan) {
+        setStorageUsed(listed);  // Listing covers the whole (shared) storage
+    } else if (status == SmsStatus::REC_UNREAD) {
+        setStorageUsed(storageUsed + listed);  // Unread ones are new slots
+    }
+    if (morePages && lastTaken < 0) {
+        fullScanNeeded = true;  // Nothing taken to page on from
+    }
+    if (resync) {
+        DEBUG_PRINTLN("WARNING: SMS storage changed outside the relay, full rescan next");
+        fullScanNeeded = true;
+        arrivalPending = true;
+    }
+
+    // Indices are listed in ascending order: continue after the last one taken
+    pageCursor = finished && morePages ? lastTaken : -1;
+
+    DEBUG_PRINTF("Read %d SMS PDUs\n", count);
+    return count > 0;
+}
+
+void SmsManager::printSms(const SmsMessage& sms) {
+    DEBUG_PRINT("From: ");
+    DEBUG_PRINTLN(sms.sender);
+    DEBUG_PRINT("Time: ");
+    DEBUG_PRINTLN(sms.timestamp);
+    if (sms.partInfo.isMultiPart) {
+        DEBUG_PRINTF("Part: %d/%d (ref: %d)\n", sms.partInfo.partNumber, sms.partInfo.totalParts, sms.partInfo.refNumber);
+    }
+    DEBUG_PRINT("Text: ");
+    DEBUG_PRINTLN(sms.text);
 }
 
 bool SmsManager::deleteSms(int index) {
@@ -149,3 +550,83 @@ bool SmsManager::deleteSms(int index) {
     DEBUG_PRINTLN("ERROR: Failed to delete SMS");
     return false;
 }
+
+int SmsManager::deleteBatch(const int* indices, int count, bool* deleted) {
+    for (int i = 0; i < count; i++) {
+        deleted[i] = false;
+    }
+    if (!initialized || count == 0) {
+        return 0;
+    }
+
+    // Bulk delete is safe only if every message known to be read is in the batch
+    uint32_t batchMask[SmsDeleteConst::MASK_WORDS] = {};
+    bool covered = !untracked && !fullScanNeeded;
+    for (int i = 0; i < count && covered; i++) {
+        if (indices[i] < 0 || indices[i] > SmsDeleteConst::MAX_INDEX) {
+            covered = false;
+        } else {
+            batchMask[indices[i] / 32] |= 1UL << (indices[i] % 32);
+        }
+    }
+    for (int w = 0; w < SmsDeleteConst::MASK_WORDS && covered; w++) {
+        covered = (readMask[w] & ~batchMask[w]) == 0;
+    }
+
+    if (covered) {
+        DEBUG_PRINTF("Deleting %d SMS with one AT+CMGD (all read)\n", count);
+        modem.sendAT("+CMGD=", indices[0], ",", SmsDeleteFlag::ALL_READ);
+        if (modem.waitResponse(5000UL) == 1) {
+            for (int i = 0; i < count; i++) {
+                deleted[i] = true;
+            }
+            for (int w = 0; w < SmsDeleteConst::MASK_WORDS; w++) {
+                seenMask[w] &= ~readMask[w];
+            }
+            memset(readMask, 0, sizeof(readMask));
+            setStorageUsed(storageUsed - count);
+            return count;
+        }
+        DEBUG_PRINTLN("WARNING: Bulk delete failed, deleting one by one");
+    }
+
+    // Chain deletes on one command line: AT+CMGD=1;+CMGD=2;...
+    // One OK covers the whole chain; on ERROR the chain is retried per index
+    int done = 0;
+    for (int start = 0; start < count; start += SmsDeleteConst::CHAIN_LENGTH) {
+        int end = min(start + SmsDeleteConst::CHAIN_LENGTH, count);
+
+        String chain = "+CMGD=" + String(indices[start]);
+        for (int i = start + 1; i < end; i++) {
+            chain += ";+CMGD=" + String(indices[i]);
+        }
+        modem.sendAT(chain);
+        if (modem.waitResponse(1000UL * (end - start)) == 1) {
+            for (int i = start; i < end; i++) {
+                deleted[i] = true;
+            }
+            done += end - start;
+            continue;
+        }
+
+        for (int i = start; i < end; i++) {
+            deleted[i] = deleteSms(indices[i]);
+            done += deleted[i] ? 1 : 0;
+        }
+    }
+
+    // Deleted slots may be reused by new SMS; a message whose delete failed
+    // is only found again by a full rescan
+    for (int i = 0; i < count; i++) {
+        if (deleted[i]) {
+            setBit(readMask, indices[i], false);
+            setBit(seenMask, indices[i], false);
+        } else {
+            fullScanNeeded = true;
+        }
+    }
+
+    setStorageUsed(storageUsed - done);
+    DEBUG_PRINTF("Deleted %d of %d SMS\n", done, count);
+    return done;
+}
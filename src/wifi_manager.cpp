@@ -1,5 +1,6 @@
 #include "wifi_manager.h"
 #include "secrets.h"
+#include "event_bus.h"
 
 bool WiFiManager::connect() {
     DEBUG_PRINTLN("=== WiFi Manager Initialization ===");
@@ -56,6 +57,23 @@ void WiFiManager::reconnect() {
     }
 }
 
+void WiFiManager::watchEvents() {
+    WiFi.onEvent(onWiFiEvent);
+    if (isConnected()) {
+        EventBus::signal(EventBit::WIFI_UP);
+    }
+}
+
+void WiFiManager::onWiFiEvent(arduino_event_id_t event) {
+    // Runs in the WiFi event task
+    if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+        EventBus::signal(EventBit::WIFI_UP);
+    } else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED || event == ARDUINO_EVENT_WIFI_STA_LOST_IP) {
+        EventBus::clear(EventBit::WIFI_UP);
+        EventBus::signal(EventBit::WIFI_LOST);
+    }
+}
+
 int WiFiManager::getRSSI() {
     return WiFi.RSSI();
 }
@@ -0,0 +1,32 @@
+#ifndef NATIVE_ARDUINO_SHIM_H
+#define NATIVE_ARDUINO_SHIM_H
+
+// Just enough of Arduino.h for the pure SMS text code to build on the host
+// Used by [env:native] only; the firmware gets the real framework header
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <strings.h>
+#include <string>
+
+class String {
+public:
+    String() {}
+    String(const char* s) : str(s ? s : "") {}
+
+    bool reserve(unsigned int size) { str.reserve(size); return true; }
+    bool concat(const char* s, unsigned int len) { str.append(s, len); return true; }
+
+    unsigned int length() const { return str.size(); }
+    const char* c_str() const { return str.c_str(); }
+
+    bool operator==(const String& other) const { return str == other.str; }
+    bool operator==(const char* other) const { return str == other; }
+
+private:
+    std::string str;
+};
+
+#endif // NATIVE_ARDUINO_SHIM_H
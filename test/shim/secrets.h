@@ -0,0 +1,15 @@
+#ifndef SECRETS_H
+#define SECRETS_H
+
+// Placeholder for host builds without include/secrets.h
+
+#define SERVER_HOST "localhost"
+#define SERVER_PORT 443
+#define API_KEY ""
+#define WIFI_SSID ""
+#define WIFI_PASSWORD ""
+#define GPRS_APN ""
+#define GPRS_USER ""
+#define GPRS_PASS ""
+
+#endif // SECRETS_H
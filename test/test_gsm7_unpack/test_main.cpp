@@ -0,0 +1,182 @@
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sms/text_decoder.h"
+
+// Word-at-a-time decodeGsm7bitTo() against the per-septet unpacker it
+// replaced: identical output, plus timings on full segments
+// Run with: pio test -e native -f test_gsm7_unpack -v (timings are printed)
+
+namespace {
+
+constexpr int MAX_OCTETS = 140;
+constexpr int OUT_SIZE = Gsm7Const::MAX_SEPTETS * Gsm7Const::MAX_UTF8_PER_SEPTET;
+constexpr int BENCH_ROUNDS = 100000;
+
+// Previous implementation: byte index and bit position math per septet,
+// with a second byte read whenever the septet spans two octets
+size_t referenceDecode(const uint8_t* data, int charCount, int paddingBits, char* out) {
+    char* p = out;
+    int bitOffset = paddingBits;
+    bool escapeNext = false;
+
+    for (int i = 0; i < charCount; i++) {
+        int byteIndex = bitOffset / 8;
+        int bitPos = bitOffset % 8;
+
+        uint8_t char7bit;
+        if (bitPos <= 1) {
+            char7bit = (data[byteIndex] >> bitPos) & Gsm7Const::MASK_7BIT;
+        } else {
+            uint8_t lowBits = data[byteIndex] >> bitPos;
+            uint8_t highBits = data[byteIndex + 1] << (8 - bitPos);
+            char7bit = (lowBits | highBits) & Gsm7Const::MASK_7BIT;
+        }
+        bitOffset += 7;
+
+        const Gsm7Utf8* entry;
+        if (escapeNext) {
+            escapeNext = false;
+            entry = &Gsm7Tables::EXTENDED[char7bit];
+            if (entry->len == 0) {
+                *p++ = '?';
+                continue;
+            }
+        } else if (char7bit == Gsm7Const::ESCAPE) {
+            escapeNext = true;
+            continue;
+        } else {
+            entry = &Gsm7Tables::BASIC[char7bit];
+        }
+
+        for (uint8_t k = 0; k < entry->len; k++) {
+            *p++ = entry->bytes[k];
+        }
+    }
+
+    return p - out;
+}
+
+// Octets actually covered by the septets (what a PDU would carry)
+int packedLength(int charCount, int paddingBits) {
+    return (paddingBits + charCount * 7 + 7) / 8;
+}
+
+// Pack septets LSB first, as in a PDU without UDH
+int packSeptets(const uint8_t* septets, int count, uint8_t* out) {
+    int octets = packedLength(count, 0);
+    memset(out, 0, octets);
+    for (int i = 0; i < count; i++) {
+        int bit = i * 7;
+        out[bit / 8] |= septets[i] << (bit % 8);
+        if (bit % 8 > 1) {
+            out[bit / 8 + 1] |= septets[i] >> (8 - bit % 8);
+        }
+    }
+    return octets;
+}
+
+void fillRandom(uint8_t* data, int len) {
+    for (int i = 0; i < len; i++) {
+        data[i] = rand() & 0xFF;
+    }
+}
+
+// Nanoseconds per call, averaged over BENCH_ROUNDS
+template <typename Decode>
+double timeDecode(Decode decode, const uint8_t* data, int charCount, int paddingBits) {
+    static char out[OUT_SIZE];
+    volatile size_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_ROUNDS; i++) {
+        sink = sink + decode(data, charCount, paddingBits, out);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / BENCH_ROUNDS;
+}
+
+size_t currentDecode(const uint8_t* data, int charCount, int paddingBits, char* out) {
+    return TextDecoder::decodeGsm7bitTo(data, charCount, paddingBits, out);
+}
+
+void benchSegment(const char* label, int charCount, int paddingBits) {
+    uint8_t data[MAX_OCTETS];
+    srand(7);
+    fillRandom(data, packedLength(charCount, paddingBits));
+
+    double before = timeDecode(referenceDecode, data, charCount, paddingBits);
+    double after = timeDecode(currentDecode, data, charCount, paddingBits);
+
+    char line[128];
+    snprintf(line, sizeof(line), "%s: %.0f ns -> %.0f ns per segment (%.2fx)",
+             label, before, after, before / after);
+    TEST_MESSAGE(line);
+}
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_matches_reference() {
+    uint8_t data[MAX_OCTETS];
+    char expected[OUT_SIZE];
+    char actual[OUT_SIZE];
+    srand(1);
+
+    for (int round = 0; round < 200; round++) {
+        for (int padding = 0; padding <= 6; padding++) {
+            for (int count = 0; count <= Gsm7Const::MAX_SEPTETS; count++) {
+                int octets = packedLength(count, padding);
+                if (octets > MAX_OCTETS) {
+                    continue;
+                }
+                fillRandom(data, octets);
+
+                size_t expectedLen = referenceDecode(data, count, padding, expected);
+                size_t actualLen = TextDecoder::decodeGsm7bitTo(data, count, padding, actual);
+                TEST_ASSERT_EQUAL_UINT(expectedLen, actualLen);
+                TEST_ASSERT_EQUAL_MEMORY(expected, actual, expectedLen);
+            }
+        }
+    }
+}
+
+void test_hindi_shift_tables() {
+    // Hindi locking shift (A.3.6) for the letters, ESC + Hindi single
+    // shift (A.2.6) for the digit, Latin letters where the tables keep them
+    const uint8_t septets[] = { 0x2F, 0x42, 0x4C, 0x5F, 0x27, 0x59, 0x20, Gsm7Const::ESCAPE, 0x1D, 0x61 };
+    const char expected[] = "नमस्ते १a";
+    uint8_t data[MAX_OCTETS];
+    char actual[OUT_SIZE];
+    Gsm7Shift shift;
+    shift.locking = Gsm7Language::HINDI;
+    shift.single = Gsm7Language::HINDI;
+
+    int count = sizeof(septets);
+    packSeptets(septets, count, data);
+    size_t length = TextDecoder::decodeGsm7bitTo(data, count, 0, actual, shift);
+    TEST_ASSERT_EQUAL_UINT(strlen(expected), length);
+    TEST_ASSERT_EQUAL_MEMORY(expected, actual, length);
+}
+
+void test_bench_single_segment() {
+    benchSegment("160 septets, no UDH", Gsm7Const::MAX_SEPTETS, 0);
+}
+
+void test_bench_concatenated_segment() {
+    // 6-octet concatenation UDH: 48 bits, 1 fill bit to the next septet
+    benchSegment("153 septets, 6-byte UDH", 153, 1);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_matches_reference);
+    RUN_TEST(test_hindi_shift_tables);
+    RUN_TEST(test_bench_single_segment);
+    RUN_TEST(test_bench_concatenated_segment);
+    return UNITY_END();
+}
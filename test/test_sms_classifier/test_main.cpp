@@ -0,0 +1,72 @@
+#include <unity.h>
+#include "sms/sms_classifier.h"
+
+// Lane heuristics of SmsClassifier: OTP keyword + standalone digit run
+// Run with: pio test -e native
+
+namespace {
+
+SmsMessage message(const char* sender, SenderClass senderClass, const char* text) {
+    SmsMessage sms;
+    sms.sender = sender;
+    sms.senderClass = senderClass;
+    sms.text = text;
+    return sms;
+}
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_otp_detected() {
+    TEST_ASSERT_TRUE(SmsClassifier::looksLikeOtp("Your code is 123456"));
+    TEST_ASSERT_TRUE(SmsClassifier::looksLikeOtp("G-482913 is your Google verification code."));
+    TEST_ASSERT_TRUE(SmsClassifier::looksLikeOtp("PIN: 4821"));
+    TEST_ASSERT_TRUE(SmsClassifier::looksLikeOtp("Verification: 123-456"));
+    TEST_ASSERT_TRUE(SmsClassifier::looksLikeOtp("OTP 123 456, valid 5 minutes"));
+    TEST_ASSERT_TRUE(SmsClassifier::looksLikeOtp("Ваш код: 5831"));
+    TEST_ASSERT_TRUE(SmsClassifier::looksLikeOtp("ВАШ КОД 1234"));
+    TEST_ASSERT_TRUE(SmsClassifier::looksLikeOtp("Пароль для входа 77120"));
+}
+
+void test_keyword_must_be_a_whole_word() {
+    TEST_ASSERT_FALSE(SmsClassifier::looksLikeOtp("Codec update 1234 ready"));
+    TEST_ASSERT_FALSE(SmsClassifier::looksLikeOtp("Pink shoes, 4821 pairs left"));
+    TEST_ASSERT_FALSE(SmsClassifier::looksLikeOtp("shopping 1234"));
+    TEST_ASSERT_FALSE(SmsClassifier::looksLikeOtp("Кодекс 2.0: 5831 страниц"));
+}
+
+void test_years_and_references_are_not_codes() {
+    TEST_ASSERT_FALSE(SmsClassifier::looksLikeOtp("Pink shoes 50% off, use code at checkout 2024"));
+    TEST_ASSERT_FALSE(SmsClassifier::looksLikeOtp("Order 5521 shipped, tracking code sent"));
+    TEST_ASSERT_FALSE(SmsClassifier::looksLikeOtp("Ref: 77120, your code follows"));
+    TEST_ASSERT_FALSE(SmsClassifier::looksLikeOtp("Заказ 5521 оплачен, код получения придет позже"));
+
+    // A reference number doesn't hide the code next to it
+    TEST_ASSERT_TRUE(SmsClassifier::looksLikeOtp("Order 5521: your code is 8830"));
+}
+
+void test_digit_run_must_stand_alone() {
+    TEST_ASSERT_FALSE(SmsClassifier::looksLikeOtp("Your code: 123"));
+    TEST_ASSERT_FALSE(SmsClassifier::looksLikeOtp("Call +79123456789 for your code"));
+    TEST_ASSERT_FALSE(SmsClassifier::looksLikeOtp("Your code A1234B"));
+    TEST_ASSERT_FALSE(SmsClassifier::looksLikeOtp("Your code is ready"));
+}
+
+void test_classify_lanes() {
+    SmsMessage otp = message("+79123456789", SenderClass::PHONE, "Your code is 123456");
+    SmsMessage promo = message("Shop", SenderClass::ALPHANUMERIC, "Pink shoes 50% off, use code at checkout 2024");
+    TEST_ASSERT_EQUAL_INT((int)SmsLane::PRIORITY, (int)SmsClassifier::classify(otp));
+    TEST_ASSERT_EQUAL_INT((int)SmsLane::BULK, (int)SmsClassifier::classify(promo));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_otp_detected);
+    RUN_TEST(test_keyword_must_be_a_whole_word);
+    RUN_TEST(test_years_and_references_are_not_codes);
+    RUN_TEST(test_digit_run_must_stand_alone);
+    RUN_TEST(test_classify_lanes);
+    return UNITY_END();
+}
@@ -0,0 +1,137 @@
+#include <unity.h>
+#include <string>
+#include "sms/text_encoder.h"
+#include "sms/text_decoder.h"
+
+// Encode → decode round-trips and segment counts for TextEncoder
+// Run with: pio test -e native
+
+namespace {
+
+std::string repeat(const char* utf8, int count) {
+    std::string out;
+    for (int i = 0; i < count; i++) {
+        out += utf8;
+    }
+    return out;
+}
+
+void assertGsm7RoundTrip(const std::string& text, int expectedSeptets) {
+    uint8_t packed[140];
+    int septets = TextEncoder::encodeGsm7bit(text.c_str(), text.size(), packed, sizeof(packed));
+    TEST_ASSERT_EQUAL_INT(expectedSeptets, septets);
+
+    String decoded = TextDecoder::decodeGsm7bit(packed, septets);
+    TEST_ASSERT_EQUAL_STRING(text.c_str(), decoded.c_str());
+}
+
+void assertUcs2RoundTrip(const std::string& text, int expectedBytes) {
+    uint8_t encoded[140];
+    int bytes = TextEncoder::encodeUcs2(text.c_str(), text.size(), encoded, sizeof(encoded));
+    TEST_ASSERT_EQUAL_INT(expectedBytes, bytes);
+
+    String decoded = TextDecoder::decodeUcs2(encoded, bytes);
+    TEST_ASSERT_EQUAL_STRING(text.c_str(), decoded.c_str());
+}
+
+void assertEstimate(const std::string& text, SmsEncoding encoding, int units, int segments) {
+    SegmentEstimate est = TextEncoder::estimate(text.c_str(), text.size());
+    TEST_ASSERT_EQUAL_INT((int)encoding, (int)est.encoding);
+    TEST_ASSERT_EQUAL_INT(units, est.units);
+    TEST_ASSERT_EQUAL_INT(segments, est.segments);
+}
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_gsm7_round_trip() {
+    assertGsm7RoundTrip("Hello, world! 123", 17);
+    assertGsm7RoundTrip("@£$¥èéùìòÇØøÅåΔ_ΦΓΛΩΠΨΣΘΞÆæßÉ", 29);
+    assertGsm7RoundTrip("ÄÖÑÜ§¿äöñüà", 11);
+
+    // Every padding offset a UDH can leave
+    const char* text = "Padding test";
+    for (int padding = 0; padding <= 6; padding++) {
+        uint8_t packed[32];
+        int septets = TextEncoder::encodeGsm7bit(text, strlen(text), packed, sizeof(packed), padding);
+        TEST_ASSERT_EQUAL_INT(12, septets);
+        TEST_ASSERT_EQUAL_STRING(text, TextDecoder::decodeGsm7bit(packed, septets, padding).c_str());
+    }
+}
+
+void test_gsm7_extension_round_trip() {
+    assertGsm7RoundTrip("€", 2);
+    assertGsm7RoundTrip("[]{}~^\\|", 16);
+    assertGsm7RoundTrip("Price: 5€ {net}", 18);
+}
+
+void test_gsm7_rejects_unrepresentable() {
+    uint8_t packed[32];
+    TEST_ASSERT_FALSE(TextEncoder::isGsm7Compatible("Привет", strlen("Привет")));
+    TEST_ASSERT_EQUAL_INT(-1, TextEncoder::encodeGsm7bit("Привет", strlen("Привет"), packed, sizeof(packed)));
+}
+
+void test_ucs2_round_trip() {
+    assertUcs2RoundTrip("Привет, мир", 22);
+    assertUcs2RoundTrip("日本語テキスト", 14);
+
+    // Whole U+0400-U+04FF block: UTF-8 lead bytes D0 to D3
+    assertUcs2RoundTrip("ЀЯаяёѢҐӀӿ", 18);
+}
+
+void test_ucs2_surrogate_pairs() {
+    assertUcs2RoundTrip("😀", 4);
+    assertUcs2RoundTrip("OK 👍🏽 done", 24);
+
+    uint8_t encoded[4];
+    TextEncoder::encodeUcs2("😀", strlen("😀"), encoded, sizeof(encoded));
+    TEST_ASSERT_EQUAL_HEX8(0xD8, encoded[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x3D, encoded[1]);
+    TEST_ASSERT_EQUAL_HEX8(0xDE, encoded[2]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, encoded[3]);
+}
+
+void test_gsm7_segment_boundaries() {
+    assertEstimate("", SmsEncoding::GSM7, 0, 0);
+    assertEstimate(repeat("a", 160), SmsEncoding::GSM7, 160, 1);
+    assertEstimate(repeat("a", 161), SmsEncoding::GSM7, 161, 2);
+    assertEstimate(repeat("a", 306), SmsEncoding::GSM7, 306, 2);
+    assertEstimate(repeat("a", 307), SmsEncoding::GSM7, 307, 3);
+
+    // Extension characters cost two septets
+    assertEstimate(repeat("€", 80), SmsEncoding::GSM7, 160, 1);
+    assertEstimate(repeat("€", 81), SmsEncoding::GSM7, 162, 2);
+
+    // An escape pair straddling the 153 boundary moves whole to the next part
+    assertEstimate(repeat("a", 152) + "€" + repeat("a", 151), SmsEncoding::GSM7, 305, 2);
+    assertEstimate(repeat("a", 152) + "€" + repeat("a", 152), SmsEncoding::GSM7, 306, 3);
+}
+
+void test_ucs2_segment_boundaries() {
+    assertEstimate(repeat("ж", 70), SmsEncoding::UCS2, 70, 1);
+    assertEstimate(repeat("ж", 71), SmsEncoding::UCS2, 71, 2);
+    assertEstimate(repeat("ж", 134), SmsEncoding::UCS2, 134, 2);
+    assertEstimate(repeat("ж", 135), SmsEncoding::UCS2, 135, 3);
+
+    // A surrogate pair counts as two units
+    assertEstimate(repeat("ж", 68) + "😀", SmsEncoding::UCS2, 70, 1);
+    assertEstimate(repeat("ж", 69) + "😀", SmsEncoding::UCS2, 71, 2);
+
+    // A surrogate pair straddling the 67 boundary moves whole to the next part
+    assertEstimate(repeat("ж", 66) + "😀" + repeat("ж", 65), SmsEncoding::UCS2, 133, 2);
+    assertEstimate(repeat("ж", 66) + "😀" + repeat("ж", 66), SmsEncoding::UCS2, 134, 3);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_gsm7_round_trip);
+    RUN_TEST(test_gsm7_extension_round_trip);
+    RUN_TEST(test_gsm7_rejects_unrepresentable);
+    RUN_TEST(test_ucs2_round_trip);
+    RUN_TEST(test_ucs2_surrogate_pairs);
+    RUN_TEST(test_gsm7_segment_boundaries);
+    RUN_TEST(test_ucs2_segment_boundaries);
+    return UNITY_END();
+}